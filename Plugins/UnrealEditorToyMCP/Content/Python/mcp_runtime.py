@@ -0,0 +1,838 @@
+"""
+Runtime support for the execute_python MCP command.
+
+The UnrealEditorMCP plugin runs every script through run(). The script
+source, its content hash and its arguments are read from the plugin via
+unreal.MCPPythonLibrary, so the statement the plugin evaluates never
+changes and the source is only transferred and compiled on a cache miss.
+
+Scripts run with a session id share one namespace across calls until the
+session is reset, closed or idle for longer than the plugin's timeout.
+
+What a script prints is captured into a bounded buffer that keeps the head
+and tail of the output, so chatty scripts cost at most the plugin's output
+cap no matter how much they print.
+
+Scripts hand structured results back with mcp.result(value), or by ending
+with an expression; the value is serialized once as JSON into the response.
+
+Scripts that yield at top level (or end with an expression that evaluates to
+a generator) run as jobs: the plugin resumes them once per frame, for as long
+as its step budget allows, until they finish or are cancelled. A yielded
+number (0-1), (done, total) pair, string or {"progress", "message"} dict is
+reported as the job's progress.
+
+mcp.actor_arrays() and mcp.set_actor_transforms() move actor transforms,
+bounds and classes between the editor and the script as packed arrays (numpy
+views when numpy is installed), one native call per array set instead of a
+reflection call per actor and property.
+
+A watchdog thread interrupts scripts that hold the game thread longer than the
+plugin's timeout (a plain script's whole run, or the time between two yields
+of a job) by raising ScriptTimeout in them. The interrupt is delivered between bytecodes,
+so a script stuck inside a single native call stops once that call returns.
+"""
+
+import array
+import ast
+import base64
+import collections
+import contextlib
+import ctypes
+import gc
+import io
+import json
+import math
+import sys
+import threading
+import time
+from types import CodeType, GeneratorType, ModuleType
+from typing import Any, Dict, List, Optional, Tuple
+
+import unreal
+
+# Compiled script: statements, the trailing expression if the script ends with one, and whether
+# the statements define a generator entry point (scripts that yield at top level)
+_CompiledScript = Tuple[CodeType, Optional[CodeType], bool]
+
+# Name of the generator function top level yielding scripts are wrapped in
+_GENERATOR_ENTRY = "__mcp_script__"
+
+# Compiled scripts keyed by content hash, least recently used first
+_code_cache: "collections.OrderedDict[str, _CompiledScript]" = collections.OrderedDict()
+
+# Upper bound of objects visited when measuring a session's memory
+_MAX_MEASURED_OBJECTS = 200000
+
+
+class _Session:
+    """Namespace kept alive between the calls of one session."""
+
+    def __init__(self) -> None:
+        self.namespace: Dict[str, Any] = _make_namespace({})
+        self.created = time.monotonic()
+        self.last_used = self.created
+        self.runs = 0
+
+
+# Sessions by id
+_sessions: Dict[str, _Session] = {}
+
+# Seconds between repeated interrupts of a script that keeps running after catching ScriptTimeout
+_REINTERRUPT_INTERVAL = 1.0
+
+
+class ScriptTimeout(KeyboardInterrupt):
+    """Raised inside a script that ran past its timeout."""
+
+
+def _interrupt(thread_id: int, exception: Any) -> None:
+    """Raise an exception asynchronously in another Python thread.
+
+    Args:
+        thread_id: threading.get_ident() of the target thread
+        exception: Exception class, or None to cancel a pending one
+    """
+    ctypes.pythonapi.PyThreadState_SetAsyncExc(
+        ctypes.c_ulong(thread_id), ctypes.py_object(exception) if exception is not None else None)
+
+
+class _Watchdog:
+    """Background thread interrupting the game thread when a script overruns.
+
+    One daemon thread is started on first use and sleeps until a guarded
+    script's deadline. The script itself never waits on it, so an idle
+    watchdog costs nothing but a condition notify per guarded call.
+    """
+
+    def __init__(self) -> None:
+        self._condition = threading.Condition()
+        self._thread: Optional[threading.Thread] = None
+        self._target = 0
+        self._timeout = 0.0
+        self._deadline: Optional[float] = None
+        self.fired = False
+
+    @contextlib.contextmanager
+    def guard(self, timeout: float) -> Any:
+        """Interrupt the calling thread if the block runs longer than the timeout.
+
+        fired tells afterwards whether the deadline was reached.
+
+        Args:
+            timeout: Seconds the block may run (0 or less disables the watchdog)
+        """
+        self.fired = False
+        if timeout <= 0:
+            yield
+            return
+
+        with self._condition:
+            self._target = threading.get_ident()
+            self._timeout = timeout
+            self._deadline = time.monotonic() + timeout
+            if self._thread is None or not self._thread.is_alive():
+                self._thread = threading.Thread(target=self._watch, name="mcp_runtime watchdog", daemon=True)
+                self._thread.start()
+            self._condition.notify()
+        try:
+            yield
+        finally:
+            with self._condition:
+                self._deadline = None
+                if self.fired:
+                    # The block may have ended before the interrupt was delivered
+                    _interrupt(self._target, None)
+
+    def postpone(self) -> None:
+        """Restart the running guard's timeout (called when a job yields).
+
+        Only moves the deadline later, which the watchdog notices when it
+        wakes up, so it needs neither the lock nor a notify.
+        """
+        if self._deadline is not None and not self.fired:
+            self._deadline = time.monotonic() + self._timeout
+
+    def _watch(self) -> None:
+        with self._condition:
+            while True:
+                if self._deadline is None:
+                    self._condition.wait()
+                    continue
+
+                remaining = self._deadline - time.monotonic()
+                if remaining > 0:
+                    self._condition.wait(remaining)
+                    continue
+
+                # Keep interrupting until the block ends, in case the script swallows the exception
+                _interrupt(self._target, ScriptTimeout)
+                self.fired = True
+                self._deadline = time.monotonic() + _REINTERRUPT_INTERVAL
+
+
+_watchdog = _Watchdog()
+
+# Vector arrays of mcp.actor_arrays(), in the order the plugin packs them
+_ACTOR_VECTOR_ARRAYS = ("location", "rotation", "scale", "bounds_origin", "bounds_extent")
+
+# numpy module, or None if it is not installed (resolved on first use)
+_numpy: Any = ...
+
+
+def _get_numpy() -> Any:
+    """Import numpy once, if it is available."""
+    global _numpy
+    if _numpy is ...:
+        try:
+            import numpy
+            _numpy = numpy
+        except ImportError:
+            _numpy = None
+    return _numpy
+
+
+def _view(buffer: bytes, offset: int, fmt: str, shape: Tuple[int, ...]) -> Any:
+    """View part of a packed buffer as an array without copying it.
+
+    Args:
+        buffer: Packed buffer
+        offset: Byte offset of the array
+        fmt: struct format of the elements ("d" or "i")
+        shape: Array shape
+
+    Returns:
+        Read-only numpy array, or a memoryview if numpy is not installed
+    """
+    count = math.prod(shape)
+    numpy = _get_numpy()
+    if numpy is not None:
+        return numpy.frombuffer(buffer, dtype=fmt, count=count, offset=offset).reshape(shape)
+
+    view = memoryview(buffer)[offset:offset + count * array.array(fmt).itemsize]
+    return view.cast(fmt, shape) if count else view.cast(fmt)
+
+
+def _pack(values: Any, count: int) -> bytes:
+    """Pack N x 3 values as native doubles.
+
+    Args:
+        values: numpy array, memoryview or sequence of 3-element sequences
+        count: Expected number of rows
+
+    Returns:
+        Packed bytes
+
+    Raises:
+        ValueError: If the values do not have count x 3 elements
+    """
+    numpy = _get_numpy()
+    if numpy is not None and isinstance(values, numpy.ndarray):
+        data = numpy.ascontiguousarray(values, dtype=numpy.float64).tobytes()
+    elif isinstance(values, memoryview) and values.format == "d":
+        data = values.tobytes()
+    else:
+        data = array.array("d", (component for row in values for component in row)).tobytes()
+
+    if len(data) != count * 3 * 8:
+        raise ValueError(f"Expected {count} x 3 values, got {len(data) // 8}")
+    return data
+
+
+class _ScriptContext:
+    """Helper bound as `mcp` in the namespace of every script."""
+
+    def __init__(self) -> None:
+        self.has_result = False
+        self.value: Any = None
+
+    def result(self, value: Any) -> None:
+        """Set the result returned to the client as JSON.
+
+        Takes precedence over the script's trailing expression.
+
+        Args:
+            value: JSON-compatible value; unreal structs, objects, names and
+                enums, sets and numpy arrays are converted as well
+        """
+        self.has_result = True
+        self.value = value
+
+    def actor_arrays(self, **filters: Any) -> Dict[str, Any]:
+        """Capture the editor world's actors as packed arrays.
+
+        Every matching actor is read natively in one call. The arrays are
+        read-only views of one decoded buffer (copy them to modify).
+
+        Args:
+            **filters: Actor filter, as for get_actors_in_level (class_name,
+                tag, box_min, box_max)
+
+        Returns:
+            Dict with ids (actor GUIDs), classes (class names), class_id (N
+            int32 indices into classes), and location, rotation (pitch, yaw,
+            roll), scale, bounds_origin and bounds_extent (N x 3 float64)
+
+        Raises:
+            ValueError: If the filter is invalid
+        """
+        count, ids, classes, data, error = unreal.MCPWorldArrayLibrary.capture_actor_arrays(json.dumps(filters))
+        if error:
+            raise ValueError(error)
+
+        buffer = base64.b64decode(data)
+        arrays: Dict[str, Any] = {
+            "ids": ids.split("\n") if count else [],
+            "classes": classes.split("\n") if classes else [],
+        }
+        offset = 0
+        for name in _ACTOR_VECTOR_ARRAYS:
+            arrays[name] = _view(buffer, offset, "d", (count, 3))
+            offset += count * 3 * 8
+        arrays["class_id"] = _view(buffer, offset, "i", (count,))
+        return arrays
+
+    def set_actor_transforms(self, ids: List[str], location: Any = None, rotation: Any = None, scale: Any = None) -> int:
+        """Set the transforms of many actors in one call (one undo transaction).
+
+        Components left as None keep their current values.
+
+        Args:
+            ids: Actor GUIDs (as returned by actor_arrays)
+            location: N x 3 locations
+            rotation: N x 3 rotations (pitch, yaw, roll)
+            scale: N x 3 scales
+
+        Returns:
+            Number of actors updated (ids not in the world are skipped)
+
+        Raises:
+            ValueError: If an id or array is invalid
+        """
+        ids = list(ids)
+        data = b"".join(_pack(values, len(ids)) for values in (location, rotation, scale) if values is not None)
+        applied, error = unreal.MCPWorldArrayLibrary.apply_actor_transforms(
+            "\n".join(ids), base64.b64encode(data).decode("ascii"),
+            location is not None, rotation is not None, scale is not None)
+        if error:
+            raise ValueError(error)
+        return applied
+
+
+class _Job:
+    """Generator script being resumed across frames."""
+
+    def __init__(self, generator: GeneratorType, context: _ScriptContext, output: "_BoundedOutput") -> None:
+        self.generator = generator
+        self.context = context
+        self.output = output
+        self.progress = -1.0
+        self.message = ""
+
+    def update(self, value: Any) -> None:
+        """Record the progress a script yielded.
+
+        Args:
+            value: Yielded value (anything that is not a progress report is ignored)
+        """
+        if isinstance(value, dict):
+            self.update(value.get("progress"))
+            self.update(value.get("message"))
+        elif isinstance(value, str):
+            self.message = value
+        elif isinstance(value, tuple) and len(value) == 2 and all(isinstance(part, (int, float)) for part in value):
+            self.progress = min(max(value[0] / value[1], 0.0), 1.0) if value[1] else 0.0
+        elif isinstance(value, (int, float)) and not isinstance(value, bool):
+            self.progress = min(max(float(value), 0.0), 1.0)
+
+
+# Jobs by the id the plugin assigned
+_jobs: Dict[str, _Job] = {}
+
+
+class _BoundedOutput(io.TextIOBase):
+    """Text stream keeping the first and last bytes written to it.
+
+    Half of the cap goes to the head of the output, the rest to a rolling
+    tail; everything in between is dropped and only counted.
+    """
+
+    def __init__(self, capacity: int, echo: Any = None) -> None:
+        """Create the stream.
+
+        Args:
+            capacity: Maximum number of UTF-8 bytes to keep
+            echo: Optional callable receiving each completed line as it is written
+        """
+        super().__init__()
+        self._head_capacity = capacity // 2
+        self._tail_capacity = capacity - self._head_capacity
+        self._head: List[bytes] = []
+        self._head_size = 0
+        self._tail: "collections.deque[bytes]" = collections.deque()
+        self._tail_size = 0
+        self._echo = echo
+        self._partial_line = ""
+        self.total_size = 0
+        self.dropped_size = 0
+
+    def writable(self) -> bool:
+        return True
+
+    def write(self, text: str) -> int:
+        data = text.encode("utf-8", "replace")
+        self.total_size += len(data)
+
+        # Fill the head first
+        if self._head_size < self._head_capacity:
+            taken = data[:self._head_capacity - self._head_size]
+            self._head.append(taken)
+            self._head_size += len(taken)
+            data = data[len(taken):]
+
+        # Then roll the tail, dropping its oldest chunks
+        if data:
+            if len(data) > self._tail_capacity:
+                self.dropped_size += len(data) - self._tail_capacity
+                data = data[len(data) - self._tail_capacity:] if self._tail_capacity else b""
+            self._tail.append(data)
+            self._tail_size += len(data)
+            while self._tail_size > self._tail_capacity:
+                oldest = self._tail.popleft()
+                overflow = self._tail_size - self._tail_capacity
+                if len(oldest) > overflow:
+                    self._tail.appendleft(oldest[overflow:])
+                    oldest = oldest[:overflow]
+                self._tail_size -= len(oldest)
+                self.dropped_size += len(oldest)
+
+        if self._echo is not None:
+            lines = (self._partial_line + text).split("\n")
+            self._partial_line = lines.pop()
+            for line in lines:
+                self._echo(line)
+
+        return len(text)
+
+    def getvalue(self) -> str:
+        """Get the kept output, with a marker where bytes were dropped."""
+        if self._echo is not None and self._partial_line:
+            self._echo(self._partial_line)
+            self._partial_line = ""
+
+        head = b"".join(self._head).decode("utf-8", "ignore")
+        tail = b"".join(self._tail).decode("utf-8", "ignore")
+        if self.dropped_size == 0:
+            return head + tail
+        return f"{head}\n... [{self.dropped_size} bytes truncated] ...\n{tail}"
+
+
+# Nodes that open a scope of their own
+_SCOPE_NODES = (ast.FunctionDef, ast.AsyncFunctionDef, ast.ClassDef, ast.Lambda,
+                ast.ListComp, ast.SetComp, ast.DictComp, ast.GeneratorExp)
+
+
+def _yields_at_top_level(body: List[ast.stmt]) -> bool:
+    """Check whether module statements contain a yield outside any function.
+
+    Args:
+        body: Module statements
+
+    Returns:
+        True if the script is meant to run as a generator
+    """
+    pending: List[ast.AST] = list(body)
+    while pending:
+        node = pending.pop()
+        if isinstance(node, (ast.Yield, ast.YieldFrom)):
+            return True
+        if not isinstance(node, _SCOPE_NODES):
+            pending.extend(ast.iter_child_nodes(node))
+    return False
+
+
+def _top_level_names(body: List[ast.stmt]) -> List[str]:
+    """Collect the names module statements bind outside any function.
+
+    Args:
+        body: Module statements
+
+    Returns:
+        Sorted names
+    """
+    names = set()
+    pending: List[ast.AST] = list(body)
+    while pending:
+        node = pending.pop()
+        if isinstance(node, (ast.FunctionDef, ast.AsyncFunctionDef, ast.ClassDef)):
+            names.add(node.name)
+            continue
+        if isinstance(node, _SCOPE_NODES):
+            continue
+        if isinstance(node, ast.Name) and isinstance(node.ctx, ast.Store):
+            names.add(node.id)
+        elif isinstance(node, (ast.Import, ast.ImportFrom)):
+            names.update((alias.asname or alias.name).split(".")[0] for alias in node.names if alias.name != "*")
+        elif isinstance(node, ast.ExceptHandler) and node.name:
+            names.add(node.name)
+        pending.extend(ast.iter_child_nodes(node))
+    return sorted(names)
+
+
+def _compile(source: str, name: str) -> _CompiledScript:
+    """Compile a script, splitting off its trailing expression.
+
+    Scripts that yield at top level are wrapped in a generator function
+    instead; the names they bind are declared global, so they still land in
+    the script's namespace.
+
+    Args:
+        source: Script source
+        name: Script name (file name in tracebacks)
+
+    Returns:
+        Compiled script
+    """
+    tree = ast.parse(source, name, "exec")
+    if _yields_at_top_level(tree.body):
+        entry = ast.parse(f"def {_GENERATOR_ENTRY}():\n    pass").body[0]
+        names = _top_level_names(tree.body)
+        entry.body = ([ast.Global(names=names)] if names else []) + tree.body
+        tree.body = [entry]
+        return compile(ast.fix_missing_locations(tree), name, "exec"), None, True
+
+    if not tree.body or not isinstance(tree.body[-1], ast.Expr):
+        return compile(tree, name, "exec"), None, False
+
+    expression = ast.Expression(tree.body.pop().value)
+    return compile(tree, name, "exec"), compile(expression, name, "eval"), False
+
+
+def _get_code(library: Any) -> Tuple[_CompiledScript, bool]:
+    """Get the compiled code of the current script.
+
+    Args:
+        library: unreal.MCPPythonLibrary
+
+    Returns:
+        Tuple of the compiled script and whether it came from the cache
+    """
+    key = library.get_script_hash()
+    code = _code_cache.get(key)
+    if code is not None:
+        _code_cache.move_to_end(key)
+        return code, True
+
+    code = _compile(library.get_script_source(), library.get_script_name())
+    _code_cache[key] = code
+
+    capacity = max(library.get_code_cache_capacity(), 0)
+    while len(_code_cache) > capacity:
+        _code_cache.popitem(last=False)
+
+    return code, False
+
+
+def _make_namespace(args: Dict[str, Any]) -> Dict[str, Any]:
+    """Build a fresh global namespace for one script run.
+
+    Args:
+        args: Arguments of the call (available as `args` and, for valid
+            identifiers, as globals of the same name)
+
+    Returns:
+        Global namespace for exec()
+    """
+    namespace: Dict[str, Any] = {
+        "__name__": "__main__",
+        "__builtins__": __builtins__,
+    }
+    namespace.update((name, value) for name, value in args.items() if name.isidentifier())
+    namespace["args"] = args
+    return namespace
+
+
+def _evict_idle_sessions(timeout: float) -> None:
+    """Close sessions that were not used within the timeout.
+
+    Args:
+        timeout: Idle timeout in seconds (0 or less keeps every session)
+    """
+    if timeout <= 0:
+        return
+
+    now = time.monotonic()
+    for session_id in [session_id for session_id, session in _sessions.items() if now - session.last_used > timeout]:
+        del _sessions[session_id]
+
+
+def _measure(namespace: Dict[str, Any]) -> int:
+    """Approximate the memory held by a namespace.
+
+    Follows references from the namespace values, skipping modules and
+    classes (shared with the rest of the interpreter). Stops after
+    _MAX_MEASURED_OBJECTS objects, so very large namespaces are
+    under-reported.
+
+    Args:
+        namespace: Session namespace
+
+    Returns:
+        Size in bytes
+    """
+    seen = {id(namespace), id(__builtins__)}
+    pending = [value for name, value in namespace.items() if name != "__builtins__"]
+    total = sys.getsizeof(namespace)
+
+    while pending and len(seen) < _MAX_MEASURED_OBJECTS:
+        obj = pending.pop()
+        if id(obj) in seen or isinstance(obj, (ModuleType, type)):
+            continue
+        seen.add(id(obj))
+        total += sys.getsizeof(obj)
+        pending.extend(gc.get_referents(obj))
+
+    return total
+
+
+def _to_json(value: Any) -> Any:
+    """Convert values json does not know natively.
+
+    Args:
+        value: Value found in a script result
+
+    Returns:
+        JSON-compatible replacement
+
+    Raises:
+        TypeError: If the value cannot be converted
+    """
+    if isinstance(value, (set, frozenset)):
+        return list(value)
+    if hasattr(value, "tolist"):
+        return value.tolist()
+    if isinstance(value, unreal.Vector):
+        return {"x": value.x, "y": value.y, "z": value.z}
+    if isinstance(value, unreal.Vector2D):
+        return {"x": value.x, "y": value.y}
+    if isinstance(value, unreal.Rotator):
+        return {"pitch": value.pitch, "yaw": value.yaw, "roll": value.roll}
+    if isinstance(value, unreal.Quat):
+        return {"x": value.x, "y": value.y, "z": value.z, "w": value.w}
+    if isinstance(value, unreal.Transform):
+        return {"location": value.translation, "rotation": value.rotation.rotator(), "scale": value.scale3d}
+    if isinstance(value, unreal.LinearColor):
+        return {"r": value.r, "g": value.g, "b": value.b, "a": value.a}
+    if isinstance(value, unreal.Color):
+        return {"r": value.r, "g": value.g, "b": value.b, "a": value.a}
+    if isinstance(value, unreal.EnumBase):
+        return value.name
+    if isinstance(value, (unreal.Name, unreal.Text)):
+        return str(value)
+    if isinstance(value, unreal.Object):
+        return value.get_path_name()
+    if isinstance(value, unreal.StructBase):
+        return value.export_text()
+    raise TypeError(f"Object of type {type(value).__name__} is not JSON serializable")
+
+
+def _describe_sessions(session_ids: List[str]) -> str:
+    """Describe sessions for the plugin.
+
+    Args:
+        session_ids: Ids of the sessions to describe
+
+    Returns:
+        JSON array of session info objects
+    """
+    now = time.monotonic()
+    return json.dumps([
+        {
+            "id": session_id,
+            "runs": session.runs,
+            "globals": len(session.namespace),
+            "memoryBytes": _measure(session.namespace),
+            "ageSeconds": now - session.created,
+            "idleSeconds": now - session.last_used,
+        }
+        for session_id, session in ((session_id, _sessions[session_id]) for session_id in session_ids)
+    ])
+
+
+def run() -> None:
+    """Run the script the plugin is currently executing."""
+    library = unreal.MCPPythonLibrary
+    _evict_idle_sessions(library.get_session_idle_timeout())
+
+    code, hit = _get_code(library)
+    library.report_code_cache(hit, len(_code_cache))
+
+    args_json = library.get_script_args()
+    args = json.loads(args_json) if args_json else {}
+
+    session_id = library.get_session_id()
+    if not session_id:
+        namespace = _make_namespace(args)
+    else:
+        session = _sessions.get(session_id)
+        if session is None:
+            session = _sessions[session_id] = _Session()
+
+        session.namespace.update((name, value) for name, value in args.items() if name.isidentifier())
+        session.namespace["args"] = args
+        session.runs += 1
+        session.last_used = time.monotonic()
+        namespace = session.namespace
+
+    context = _ScriptContext()
+    namespace["mcp"] = context
+
+    statements, expression, is_generator = code
+    output = _BoundedOutput(
+        max(library.get_output_capacity(), 0) if library.is_output_included() else 0,
+        library.echo_output if library.is_output_echo_enabled() else None)
+    try:
+        with _watchdog.guard(library.get_timeout()), \
+                contextlib.redirect_stdout(output), contextlib.redirect_stderr(output):
+            exec(statements, namespace)
+            if is_generator:
+                value = namespace.pop(_GENERATOR_ENTRY)()
+            else:
+                value = eval(expression, namespace) if expression is not None else None
+    except BaseException:
+        _report_failure(library, output)
+        raise
+
+    if _watchdog.fired:
+        # The script caught ScriptTimeout and finished anyway; it still overran
+        _report_failure(library, output)
+        return
+
+    if isinstance(value, GeneratorType):
+        job_id = library.get_job_id()
+        _jobs[job_id] = _Job(value, context, output)
+        _step(library, job_id)
+        return
+
+    if not context.has_result and value is not None:
+        context.result(value)
+    _finish(library, context, output)
+
+
+def resume() -> None:
+    """Resume the job the plugin is currently stepping."""
+    _step(unreal.MCPPythonLibrary, unreal.MCPPythonLibrary.get_job_id())
+
+
+def discard() -> None:
+    """Drop the job the plugin abandoned, running its cleanup (finally blocks)."""
+    library = unreal.MCPPythonLibrary
+    job = _jobs.pop(library.get_job_id(), None)
+    if job is not None:
+        with _watchdog.guard(library.get_timeout()):
+            job.generator.close()
+
+
+def _step(library: Any, job_id: str) -> None:
+    """Resume a job until it finishes or the step budget is used up.
+
+    Cancellation is checked before every resume, so a cancelled job stops at
+    its next yield.
+
+    Args:
+        library: unreal.MCPPythonLibrary
+        job_id: Id of the job
+    """
+    job = _jobs[job_id]
+    deadline = time.perf_counter() + library.get_step_budget()
+    finished = False
+    cancelled = False
+    try:
+        with _watchdog.guard(library.get_timeout()), \
+                contextlib.redirect_stdout(job.output), contextlib.redirect_stderr(job.output):
+            while True:
+                if library.is_cancel_requested():
+                    job.generator.close()
+                    cancelled = True
+                    break
+                try:
+                    value = next(job.generator)
+                except StopIteration as stop:
+                    if not job.context.has_result and stop.value is not None:
+                        job.context.result(stop.value)
+                    finished = True
+                    break
+                job.update(value)
+                _watchdog.postpone()
+                if time.perf_counter() >= deadline:
+                    break
+    except BaseException:
+        del _jobs[job_id]
+        _report_failure(library, job.output)
+        raise
+
+    if _watchdog.fired:
+        del _jobs[job_id]
+        job.generator.close()
+        _report_failure(library, job.output)
+        return
+
+    if not finished and not cancelled:
+        library.report_job_state(False, False, job.progress, job.message)
+        return
+
+    del _jobs[job_id]
+    library.report_job_state(True, cancelled, 1.0 if finished else job.progress, job.message)
+    _finish(library, job.context, job.output)
+
+
+def _report_failure(library: Any, output: _BoundedOutput) -> None:
+    """Report the partial output of a script that raised or timed out.
+
+    Args:
+        library: unreal.MCPPythonLibrary
+        output: The script's output
+    """
+    library.report_output(output.getvalue(), output.total_size, output.dropped_size)
+    if _watchdog.fired:
+        library.report_timeout()
+
+
+def _finish(library: Any, context: _ScriptContext, output: _BoundedOutput) -> None:
+    """Report the output and result of a completed script.
+
+    Args:
+        library: unreal.MCPPythonLibrary
+        context: The script's mcp helper
+        output: The script's output
+    """
+    library.report_output(output.getvalue(), output.total_size, output.dropped_size)
+    if context.has_result:
+        library.report_result(json.dumps(context.value, default=_to_json, allow_nan=False))
+
+
+def manage_sessions() -> None:
+    """Apply the session action the plugin requested and report the sessions."""
+    library = unreal.MCPPythonLibrary
+    _evict_idle_sessions(library.get_session_idle_timeout())
+
+    action = library.get_session_action()
+    session_id = library.get_session_id()
+
+    if action == "reset" and session_id in _sessions:
+        _sessions[session_id] = _Session()
+    elif action == "close":
+        _sessions.pop(session_id, None)
+    elif action == "close_all":
+        _sessions.clear()
+
+    if action == "list":
+        reported = sorted(_sessions)
+    else:
+        reported = [session_id] if session_id in _sessions else []
+    library.report_sessions(_describe_sessions(reported))
+
+
+def clear_code_cache() -> None:
+    """Drop every compiled script."""
+    _code_cache.clear()
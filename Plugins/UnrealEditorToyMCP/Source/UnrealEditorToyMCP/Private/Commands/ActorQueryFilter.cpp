@@ -0,0 +1,154 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ActorQueryFilter.h"
+#include "GameFramework/Actor.h"
+#include "JsonObjectConverter.h"
+#include "MCPJsonStructs.h"
+#include "MCPWorldSnapshot.h"
+
+namespace
+{
+	FVector ToVector(const FMCPVector3& Vector)
+	{
+		return FVector(Vector.x, Vector.y, Vector.z);
+	}
+
+	// Set the criteria that do not depend on where actors are read from (tag, box)
+	void SetTagAndBox(const FGetActorsInLevelCommandParams& Params, FActorQueryFilter& OutFilter)
+	{
+		if (!Params.tag.IsEmpty())
+		{
+			OutFilter.Tag = FName(*Params.tag);
+		}
+
+		if (Params.bHasBox)
+		{
+			const FVector BoxMin = ToVector(Params.box_min);
+			const FVector BoxMax = ToVector(Params.box_max);
+			OutFilter.Box = FBox(BoxMin.ComponentMin(BoxMax), BoxMin.ComponentMax(BoxMax));
+			OutFilter.bHasBox = true;
+		}
+	}
+}
+
+bool FActorQueryFilter::Decode(const TSharedPtr<FJsonObject>& Params, FGetActorsInLevelCommandParams& OutParams, FString& OutError)
+{
+	OutParams = FGetActorsInLevelCommandParams();
+
+	if (!Params.IsValid())
+	{
+		return true;
+	}
+
+	// Absent corners decode to zero, so whether a box was given is read from the JSON
+	const bool bHasBoxMin = Params->HasField(TEXT("box_min"));
+	const bool bHasBoxMax = Params->HasField(TEXT("box_max"));
+	if (bHasBoxMin || bHasBoxMax)
+	{
+		if (!Params->HasTypedField<EJson::Object>(TEXT("box_min")) || !Params->HasTypedField<EJson::Object>(TEXT("box_max")))
+		{
+			OutError = TEXT("'box_min' and 'box_max' must both be objects with x, y, z");
+			return false;
+		}
+		OutParams.bHasBox = true;
+	}
+
+	if (!FJsonObjectConverter::JsonObjectToUStruct(Params.ToSharedRef(), &OutParams))
+	{
+		OutError = TEXT("Invalid actor filter");
+		return false;
+	}
+	return true;
+}
+
+bool FActorQueryFilter::Resolve(const FGetActorsInLevelCommandParams& Params, FActorQueryFilter& OutFilter, FString& OutError)
+{
+	OutFilter = FActorQueryFilter();
+
+	// class_name
+	if (!Params.class_name.IsEmpty())
+	{
+		OutFilter.ActorClass = Params.class_name.Contains(TEXT("/"))
+			                       ? FindObject<UClass>(nullptr, *Params.class_name)
+			                       : FindFirstObject<UClass>(*Params.class_name, EFindFirstObjectOptions::NativeFirst);
+
+		if (!OutFilter.ActorClass || !OutFilter.ActorClass->IsChildOf(AActor::StaticClass()))
+		{
+			OutError = FString::Printf(TEXT("Unknown actor class: %s"), *Params.class_name);
+			return false;
+		}
+	}
+
+	SetTagAndBox(Params, OutFilter);
+	return true;
+}
+
+bool FActorQueryFilter::ResolveForSnapshot(const FGetActorsInLevelCommandParams& Params, const FMCPWorldSnapshot& Snapshot,
+                                           FActorQueryFilter& OutFilter)
+{
+	OutFilter = FActorQueryFilter();
+	SetTagAndBox(Params, OutFilter);
+
+	// class_name (a class no snapshot actor derives from may still exist; leave that to Resolve)
+	if (!Params.class_name.IsEmpty())
+	{
+		OutFilter.SnapshotClassIndex = Snapshot.FindClass(Params.class_name);
+		if (OutFilter.SnapshotClassIndex == INDEX_NONE)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool FActorQueryFilter::Parse(const TSharedPtr<FJsonObject>& Params, FActorQueryFilter& OutFilter, FString& OutError)
+{
+	FGetActorsInLevelCommandParams FilterParams;
+	return Decode(Params, FilterParams, OutError) && Resolve(FilterParams, OutFilter, OutError);
+}
+
+bool FActorQueryFilter::Matches(const AActor* Actor) const
+{
+	if (!Actor)
+	{
+		return false;
+	}
+
+	if (ActorClass && !Actor->IsA(ActorClass))
+	{
+		return false;
+	}
+
+	if (!Tag.IsNone() && !Actor->ActorHasTag(Tag))
+	{
+		return false;
+	}
+
+	if (bHasBox && !Box.IsInsideOrOn(Actor->GetActorLocation()))
+	{
+		return false;
+	}
+
+	return true;
+}
+
+bool FActorQueryFilter::Matches(const FMCPWorldSnapshot& Snapshot, const FMCPSnapshotActor& Actor) const
+{
+	if (SnapshotClassIndex != INDEX_NONE && !Snapshot.IsChildOf(Actor.ClassIndex, SnapshotClassIndex))
+	{
+		return false;
+	}
+
+	if (!Tag.IsNone() && !Actor.Tags.Contains(Tag))
+	{
+		return false;
+	}
+
+	if (bHasBox && !Box.IsInsideOrOn(Actor.Location))
+	{
+		return false;
+	}
+
+	return true;
+}
@@ -0,0 +1,95 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "IEditorCommand.h"
+
+class AActor;
+class FMCPWorldSnapshot;
+struct FGetActorsInLevelCommandParams;
+struct FMCPSnapshotActor;
+
+/**
+ * Actor filter shared by commands that select actors in the editor world
+ * Every criterion that is set must match; an empty filter matches all actors.
+ * Parameters (decoded into FGetActorsInLevelCommandParams):
+ *   - class_name (optional): Actor class name; subclasses match as well
+ *   - tag (optional): Actor tag that must be present
+ *   - box_min / box_max (optional): World-space box the actor location must be inside
+ */
+struct FActorQueryFilter
+{
+	/** Required actor class (nullptr = any class) */
+	UClass* ActorClass = nullptr;
+
+	/** Required actor class as an index into the snapshot's class table (only set by ResolveForSnapshot) */
+	int32 SnapshotClassIndex = INDEX_NONE;
+
+	/** Required actor tag (NAME_None = any tag) */
+	FName Tag;
+
+	/** World-space box the actor location must be inside (only used when bHasBox is set) */
+	FBox Box = FBox(ForceInit);
+	bool bHasBox = false;
+
+	/**
+	 * Decode and validate filter parameters
+	 * Safe to call from any thread, so bad filters are rejected before they are queued
+	 * @param Params JSON object containing the filter parameters (may be null)
+	 * @param OutParams Decoded params
+	 * @param OutError Error message when a parameter is invalid
+	 * @return True on success, false if a parameter is invalid
+	 */
+	static bool Decode(const TSharedPtr<FJsonObject>& Params, FGetActorsInLevelCommandParams& OutParams, FString& OutError);
+
+	/**
+	 * Build a filter from decoded parameters
+	 * Must be called on the game thread (resolves the class by name)
+	 * @param Params Params from Decode
+	 * @param OutFilter Built filter
+	 * @param OutError Error message when the class does not exist
+	 * @return True on success, false if the class is unknown
+	 */
+	static bool Resolve(const FGetActorsInLevelCommandParams& Params, FActorQueryFilter& OutFilter, FString& OutError);
+
+	/**
+	 * Build a filter for matching actors of a world snapshot
+	 * Safe to call from any thread; the class is looked up in the snapshot's class table
+	 * @param Params Params from Decode
+	 * @param Snapshot Snapshot the filter will be matched against
+	 * @param OutFilter Built filter
+	 * @return True on success, false if the class is not in the snapshot, in which case only
+	 *         Resolve on the game thread can tell whether it exists
+	 */
+	static bool ResolveForSnapshot(const FGetActorsInLevelCommandParams& Params, const FMCPWorldSnapshot& Snapshot,
+	                               FActorQueryFilter& OutFilter);
+
+	/**
+	 * Decode a filter object and build the filter in one go (selectors of bulk edit commands, Python)
+	 * Must be called on the game thread
+	 * @param Params JSON filter object (may be null)
+	 * @param OutFilter Built filter
+	 * @param OutError Error message when a parameter is invalid or the class is unknown
+	 * @return True on success
+	 */
+	static bool Parse(const TSharedPtr<FJsonObject>& Params, FActorQueryFilter& OutFilter, FString& OutError);
+
+	/**
+	 * Check whether an actor passes the filter
+	 * @param Actor Actor to test
+	 * @return True if every criterion that is set matches
+	 */
+	bool Matches(const AActor* Actor) const;
+
+	/**
+	 * Check whether a snapshot actor passes a filter built by ResolveForSnapshot
+	 * @param Snapshot Snapshot the actor belongs to
+	 * @param Actor Actor to test
+	 * @return True if every criterion that is set matches
+	 */
+	bool Matches(const FMCPWorldSnapshot& Snapshot, const FMCPSnapshotActor& Actor) const;
+
+	/** True if no criterion is set */
+	bool IsEmpty() const { return ActorClass == nullptr && SnapshotClassIndex == INDEX_NONE && Tag.IsNone() && !bHasBox; }
+};
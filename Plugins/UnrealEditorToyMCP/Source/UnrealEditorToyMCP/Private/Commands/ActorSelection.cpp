@@ -0,0 +1,87 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ActorSelection.h"
+#include "ActorQueryFilter.h"
+#include "BulkEditTask.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GameFramework/Actor.h"
+#include "MCPJsonStructs.h"
+
+bool FActorSelection::Resolve(UWorld& World, const TArray<FString>& Ids, const FJsonObjectWrapper& Selector,
+                              TArray<AActor*>& OutActors, TArray<FMCPItemError>& OutErrors, FString& OutError)
+{
+	OutActors.Reset();
+
+	const bool bIds = Ids.Num() > 0;
+	const bool bSelector = Selector.JsonObject.IsValid();
+	if (bIds == bSelector)
+	{
+		OutError = bIds ? TEXT("Pass either 'ids' or 'selector', not both") : TEXT("Either 'ids' or 'selector' is required");
+		return false;
+	}
+
+	// 1. Selector: every actor the filter matches
+	if (bSelector)
+	{
+		FActorQueryFilter Filter;
+		if (!FActorQueryFilter::Parse(Selector.JsonObject, Filter, OutError))
+		{
+			return false;
+		}
+
+		for (TActorIterator<AActor> It(&World); It; ++It)
+		{
+			if (Filter.Matches(*It))
+			{
+				OutActors.Add(*It);
+			}
+		}
+		return true;
+	}
+
+	// 2. Ids: look every id up in one pass
+	OutActors.SetNumZeroed(Ids.Num());
+
+	TMap<FGuid, int32> IndexById;
+	IndexById.Reserve(Ids.Num());
+	for (int32 Index = 0; Index < Ids.Num(); ++Index)
+	{
+		FGuid Id;
+		if (!FGuid::Parse(Ids[Index], Id))
+		{
+			FBulkEdit::AddItemError(OutErrors, Index, FString::Printf(TEXT("Invalid actor id: %s"), *Ids[Index]));
+		}
+		else if (IndexById.Contains(Id))
+		{
+			FBulkEdit::AddItemError(OutErrors, Index, FString::Printf(TEXT("Duplicate actor id %s"), *Ids[Index]));
+		}
+		else
+		{
+			IndexById.Add(Id, Index);
+		}
+	}
+
+	int32 NumFound = 0;
+	for (TActorIterator<AActor> It(&World); It && NumFound < IndexById.Num(); ++It)
+	{
+		if (const int32* Index = IndexById.Find(It->GetActorGuid()))
+		{
+			OutActors[*Index] = *It;
+			++NumFound;
+		}
+	}
+
+	if (NumFound < IndexById.Num())
+	{
+		for (const TPair<FGuid, int32>& Entry : IndexById)
+		{
+			if (!OutActors[Entry.Value])
+			{
+				FBulkEdit::AddItemError(OutErrors, Entry.Value, FString::Printf(TEXT("No actor with id %s"), *Ids[Entry.Value]));
+			}
+		}
+	}
+	OutErrors.Sort([](const FMCPItemError& A, const FMCPItemError& B) { return A.index < B.index; });
+	return true;
+}
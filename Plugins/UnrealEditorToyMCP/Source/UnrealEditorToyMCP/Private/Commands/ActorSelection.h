@@ -0,0 +1,33 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class AActor;
+class UWorld;
+struct FJsonObjectWrapper;
+struct FMCPItemError;
+
+/**
+ * Actors a bulk edit command applies to, given either by id or by an FActorQueryFilter selector
+ * Parameters (one or the other):
+ *   - ids: Actor GUIDs
+ *   - selector: Filter object {class_name, tag, box_min, box_max}; {} selects every actor
+ */
+struct FActorSelection
+{
+	/**
+	 * Find the selected actors in one pass over the world
+	 * Must be called on the game thread
+	 * @param World World to select from
+	 * @param Ids Actor GUIDs (empty when a selector is used)
+	 * @param Selector Filter object (no object when ids are used)
+	 * @param OutActors Selected actors; for ids, one entry per id (nullptr if it was not found)
+	 * @param OutErrors Ids that are invalid, duplicated or not found, as {index into ids, error}
+	 * @param OutError Error message when the selection itself is invalid
+	 * @return True if the selection is valid (individual ids may still have failed)
+	 */
+	static bool Resolve(UWorld& World, const TArray<FString>& Ids, const FJsonObjectWrapper& Selector,
+	                    TArray<AActor*>& OutActors, TArray<FMCPItemError>& OutErrors, FString& OutError);
+};
@@ -0,0 +1,109 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ActorTransformBatch.h"
+#include "AI/NavigationSystemBase.h"
+#include "Components/SceneComponent.h"
+#include "Editor.h"
+#include "EditorSupportDelegates.h"
+#include "Engine/BlueprintGeneratedClass.h"
+#include "Engine/StaticMeshActor.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+
+namespace
+{
+	/**
+	 * True if the actor's move handling is AActor::PostEditMove itself, which a batch can split up
+	 * Subclasses that override it (brushes, volumes, landscapes, splines...) get their own
+	 * PostEditMove; there is no way to ask whether a virtual is overridden, so only the native
+	 * bases known to keep AActor's are batched.
+	 */
+	bool UsesActorPostEditMove(const UClass* Class)
+	{
+		while (Class && !Class->HasAnyClassFlags(CLASS_Native))
+		{
+			Class = Class->GetSuperClass();
+		}
+		return Class == AActor::StaticClass() || Class == AStaticMeshActor::StaticClass();
+	}
+}
+
+void FActorTransformBatch::Apply(AActor& Actor, const FTransform& Transform)
+{
+	Actor.Modify();
+	Actor.SetActorTransform(Transform, false, nullptr, ETeleportType::TeleportPhysics);
+
+	// Native actors have no construction script that could react to the move; actors with their
+	// own PostEditMove rerun it from there in Finish
+	if (Cast<UBlueprintGeneratedClass>(Actor.GetClass()) && UsesActorPostEditMove(Actor.GetClass()))
+	{
+		Actor.RerunConstructionScripts();
+	}
+
+	MovedActors.Add(&Actor);
+}
+
+void FActorTransformBatch::Finish()
+{
+	TArray<AActor*> Actors;
+	Actors.Reserve(MovedActors.Num());
+	for (const TWeakObjectPtr<AActor>& MovedActor : MovedActors)
+	{
+		if (AActor* Actor = MovedActor.Get())
+		{
+			Actors.Add(Actor);
+		}
+	}
+	MovedActors.Reset();
+
+	if (Actors.Num() == 0)
+	{
+		return;
+	}
+
+	// 1. What PostEditMove(true) does per actor, without the editor refreshes; navigation is
+	//    rebuilt once the lock is released
+	{
+		UWorld* World = Actors[0]->GetWorld();
+		FNavigationLockContext NavigationLock(World, ENavigationLockReason::ContinuousEditorMove);
+		for (AActor* Actor : Actors)
+		{
+			if (!UsesActorPostEditMove(Actor->GetClass()))
+			{
+				Actor->PostEditMove(true);
+				continue;
+			}
+
+			if (GEngine)
+			{
+				GEngine->BroadcastOnActorMoved(Actor);
+			}
+			USceneComponent* RootComponent = Actor->GetRootComponent();
+			if (RootComponent && !RootComponent->IsCreatedByConstructionScript())
+			{
+				RootComponent->PostEditComponentMove(true);
+			}
+			FNavigationSystem::OnPostEditActorMove(*Actor);
+			if (World)
+			{
+				World->UpdateCullDistanceVolumes(Actor);
+			}
+		}
+		if (World)
+		{
+			World->bAreConstraintsDirty = true;
+		}
+	}
+
+	// 2. One batch notification and one editor refresh for all of them
+	if (GEngine)
+	{
+		GEngine->BroadcastActorsMoved(Actors);
+	}
+	FEditorSupportDelegates::RefreshPropertyWindows.Broadcast();
+	FEditorSupportDelegates::UpdateUI.Broadcast();
+	if (GEditor)
+	{
+		GEditor->RedrawLevelEditingViewports();
+	}
+}
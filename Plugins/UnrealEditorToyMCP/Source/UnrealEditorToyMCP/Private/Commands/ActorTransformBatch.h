@@ -0,0 +1,38 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class AActor;
+
+/**
+ * Moves many actors with the editor's per-actor move notifications deferred to one batch
+ * AActor::PostEditMove refreshes property windows and the editor UI for every actor it is called
+ * on. A batch only moves the actors (rerunning construction scripts where a Blueprint may depend on
+ * the transform); Finish then does the rest of PostEditMove per actor (OnActorMoved, the root
+ * component's PostEditComponentMove, navigation and cull distance volumes) and refreshes the editor
+ * once, with a single OnActorsMoved for all of them. Actors whose class overrides PostEditMove get
+ * a full PostEditMove(true) in Finish instead.
+ * Game thread only; the caller provides the undo transaction.
+ */
+class FActorTransformBatch
+{
+public:
+	/**
+	 * Move one actor, recording it for undo
+	 * @param Actor Actor to move
+	 * @param Transform New actor transform
+	 */
+	void Apply(AActor& Actor, const FTransform& Transform);
+
+	/** Notify the editor once about every actor moved since the last Finish */
+	void Finish();
+
+	/** Number of actors moved since the last Finish */
+	int32 Num() const { return MovedActors.Num(); }
+
+private:
+	// Weak, since a batch may span several frames
+	TArray<TWeakObjectPtr<AActor>> MovedActors;
+};
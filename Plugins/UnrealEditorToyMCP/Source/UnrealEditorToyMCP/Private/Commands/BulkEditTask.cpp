@@ -0,0 +1,11 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "BulkEditTask.h"
+#include "MCPJsonStructs.h"
+
+void FBulkEdit::AddItemError(TArray<FMCPItemError>& OutErrors, const int32 Index, const FString& Error)
+{
+	FMCPItemError& ItemError = OutErrors.AddDefaulted_GetRef();
+	ItemError.index = Index;
+	ItemError.error = Error;
+}
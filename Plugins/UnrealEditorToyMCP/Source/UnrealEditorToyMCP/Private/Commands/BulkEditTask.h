@@ -0,0 +1,74 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EditorCommandTransaction.h"
+#include "IEditorCommand.h"
+
+struct FMCPItemError;
+
+/**
+ * Helpers shared by the bulk edit commands
+ */
+struct FBulkEdit
+{
+	/**
+	 * Report an item of a bulk request that could not be processed
+	 * @param OutErrors Item errors of the response
+	 * @param Index Index of the item in the request
+	 * @param Error Error message
+	 */
+	static void AddItemError(TArray<FMCPItemError>& OutErrors, int32 Index, const FString& Error);
+};
+
+/**
+ * Base class for the resumable tasks of bulk edit commands
+ * Holds the decoded params, the undo transaction the steps record into and the response that is
+ * filled in along the way. ResponseType must have an 'errors' array of FMCPItemError and an 'error' string.
+ */
+template<typename ParamsType, typename ResponseType>
+class TBulkEditTask : public IEditorCommandTask
+{
+protected:
+	TBulkEditTask(const ParamsType& InParams, const FText& TransactionDescription)
+		: Params(InParams)
+		  , Transaction(TransactionDescription)
+	{
+	}
+
+	/**
+	 * Fail the task if its transaction was ended early (map load, world cleanup, PIE start)
+	 * Called at the start of every step: the actors being edited may no longer exist.
+	 * @return True if the task was interrupted and must not continue
+	 */
+	bool AbortIfInterrupted()
+	{
+		if (!Transaction.IsInterrupted())
+		{
+			return false;
+		}
+		if (Response.error.IsEmpty())
+		{
+			Response.error = Transaction.GetInterruptReason();
+		}
+		return true;
+	}
+
+	void AddError(const int32 Index, const FString& Error)
+	{
+		FBulkEdit::AddItemError(Response.errors, Index, Error);
+	}
+
+	static double ToMilliseconds(const double Seconds)
+	{
+		return Seconds * 1000.0;
+	}
+
+	// Params are owned by the scheduler request and outlive the task
+	const ParamsType& Params;
+
+	FEditorCommandTransaction Transaction;
+
+	ResponseType Response;
+};
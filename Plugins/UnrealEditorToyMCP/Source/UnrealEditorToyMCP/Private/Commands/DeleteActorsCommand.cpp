@@ -0,0 +1,362 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "DeleteActorsCommand.h"
+#include "ActorEditorUtils.h"
+#include "ActorSelection.h"
+#include "BulkEditTask.h"
+#include "Components/SceneComponent.h"
+#include "Editor.h"
+#include "Editor/GroupActor.h"
+#include "EditorSupportDelegates.h"
+#include "Engine/LevelScriptBlueprint.h"
+#include "Engine/Selection.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GameFramework/Actor.h"
+#include "GameFramework/WorldSettings.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "Layers/LayersSubsystem.h"
+#include "MCPJsonStructs.h"
+
+#define LOCTEXT_NAMESPACE "DeleteActorsCommand"
+
+FString FDeleteActorsCommand::GetName() const
+{
+	return TEXT("delete_actors");
+}
+
+FString FDeleteActorsCommand::GetDescription() const
+{
+	return TEXT("Delete many actors (selected by id or filter) as one undo transaction, skipping actors that are still referenced");
+}
+
+namespace
+{
+	/**
+	 * Resumable deletion of every selected actor
+	 * The first step selects the actors, checks them for references and deselects them; they are
+	 * then deleted in strides between clock checks, and the editor is refreshed after the last one.
+	 */
+	class FDeleteActorsTask : public TBulkEditTask<FDeleteActorsCommandParams, FDeleteActorsCommandResponse>
+	{
+	public:
+		explicit FDeleteActorsTask(const FDeleteActorsCommandParams& InParams)
+			: TBulkEditTask(InParams, LOCTEXT("DeleteActors", "MCP: Delete Actors"))
+		{
+			// An empty filter matches every actor; never delete the whole level by accident
+			if (Params.selector.JsonObject.IsValid() && Params.selector.JsonObject->Values.Num() == 0)
+			{
+				Response.error = TEXT("'selector' must set at least one criterion");
+			}
+		}
+
+		virtual ~FDeleteActorsTask() override
+		{
+			// Abandoned mid-delete (server shutdown): still refresh the editor for what was deleted
+			NotifyDeleted();
+		}
+
+		virtual EEditorCommandStepResult Step(const double BudgetSeconds) override
+		{
+			if (AbortIfInterrupted() || !Response.error.IsEmpty())
+			{
+				return EEditorCommandStepResult::Done;
+			}
+
+			const double StartTime = FPlatformTime::Seconds();
+			const double EndTime = StartTime + BudgetSeconds;
+			++Response.steps;
+
+			// 1. Select, check references and deselect, all at once
+			if (!bResolved)
+			{
+				if (!Resolve())
+				{
+					return EEditorCommandStepResult::Done;
+				}
+				bResolved = true;
+				Response.timings.resolveMs = ToMilliseconds(FPlatformTime::Seconds() - StartTime);
+			}
+
+			// 2. Delete in strides
+			constexpr int32 ActorsPerClockCheck = 32;
+			const double ApplyStartTime = FPlatformTime::Seconds();
+			if (Actors.Num() > 0)
+			{
+				Transaction.Begin();
+			}
+
+			while (NextIndex < Actors.Num())
+			{
+				if (AActor* Actor = Actors[NextIndex].Get())
+				{
+					DeleteActor(*Actor);
+				}
+				++NextIndex;
+
+				if (NextIndex % ActorsPerClockCheck == 0 && FPlatformTime::Seconds() >= EndTime)
+				{
+					Response.timings.applyMs += ToMilliseconds(FPlatformTime::Seconds() - ApplyStartTime);
+					return EEditorCommandStepResult::Continue;
+				}
+			}
+
+			const double NotifyStartTime = FPlatformTime::Seconds();
+			Response.timings.applyMs += ToMilliseconds(NotifyStartTime - ApplyStartTime);
+
+			// 3. Refresh the editor once for the whole batch and close the undo step
+			NotifyDeleted();
+			Transaction.End();
+			Response.timings.notifyMs = ToMilliseconds(FPlatformTime::Seconds() - NotifyStartTime);
+
+			return EEditorCommandStepResult::Done;
+		}
+
+		virtual TArray<FEditorCommandResult> Finish() override
+		{
+			if (Response.error.IsEmpty() && (Response.errors.Num() > 0 || Response.skipped.Num() > 0))
+			{
+				Response.error = FString::Printf(TEXT("%d actors could not be deleted, %d were skipped because they are still referenced"),
+				                                 Response.errors.Num(), Response.skipped.Num());
+			}
+			Response.success = Response.error.IsEmpty();
+			return {FEditorCommandResult::Make(MoveTemp(Response))};
+		}
+
+	private:
+		bool Resolve()
+		{
+			UWorld* EditorWorld = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
+			if (!EditorWorld)
+			{
+				Response.error = TEXT("No editor world available");
+				return false;
+			}
+
+			TArray<AActor*> Selected;
+			if (!FActorSelection::Resolve(*EditorWorld, Params.ids, Params.selector, Selected, Response.errors, Response.error))
+			{
+				return false;
+			}
+
+			// 1. Drop the actors the editor never deletes
+			TSet<AActor*> Doomed;
+			Doomed.Reserve(Selected.Num());
+			for (int32 Index = 0; Index < Selected.Num(); ++Index)
+			{
+				AActor* Actor = Selected[Index];
+				if (!Actor)
+				{
+					continue;
+				}
+				++Response.matched;
+
+				FText Reason;
+				if (Actor->IsA<AWorldSettings>() || FActorEditorUtils::IsABuilderBrush(Actor))
+				{
+					AddError(Index, FString::Printf(TEXT("%s cannot be deleted"), *Actor->GetActorLabel()));
+				}
+				else if (!Actor->CanDeleteSelectedActor(Reason))
+				{
+					AddError(Index, FString::Printf(TEXT("%s cannot be deleted: %s"), *Actor->GetActorLabel(), *Reason.ToString()));
+				}
+				else
+				{
+					Doomed.Add(Actor);
+				}
+			}
+			Response.errors.Sort([](const FMCPItemError& A, const FMCPItemError& B) { return A.index < B.index; });
+
+			// 2. Keep the referenced ones unless forced
+			if (!Params.force && Doomed.Num() > 0)
+			{
+				TMap<AActor*, TArray<FString>> Referencers;
+				KeepReferenced(*EditorWorld, Doomed, Referencers);
+
+				for (TPair<AActor*, TArray<FString>>& Entry : Referencers)
+				{
+					FMCPSkippedActor& Skipped = Response.skipped.AddDefaulted_GetRef();
+					Skipped.id = Entry.Key->GetActorGuid().ToString(EGuidFormats::DigitsWithHyphens);
+					Skipped.label = Entry.Key->GetActorLabel();
+					Skipped.referenced_by = MoveTemp(Entry.Value);
+				}
+			}
+
+			// 3. Deselect in one selection change, keeping the input order for deletion
+			USelection* Selection = GEditor->GetSelectedActors();
+			Selection->BeginBatchSelectOperation();
+			for (AActor* Actor : Selected)
+			{
+				if (Actor && Doomed.Contains(Actor))
+				{
+					Selection->Deselect(Actor);
+					Actors.Add(Actor);
+				}
+			}
+			Selection->EndBatchSelectOperation(false);
+			GEditor->NoteSelectionChange();
+
+			return true;
+		}
+
+		/**
+		 * Drop every doomed actor that something staying references, until nothing changes
+		 * An actor that is dropped stays in the level, so its own references are checked in turn.
+		 * References to a component (an attach parent, a component reference) count as references
+		 * to its owner.
+		 */
+		static void KeepReferenced(UWorld& World, TSet<AActor*>& Doomed, TMap<AActor*, TArray<FString>>& OutReferencers)
+		{
+			TArray<UObject*> References;
+			FReferenceFinder Finder(References, nullptr, false, true, false, false);
+
+			// Actors still to check as referencers; starts with every actor that stays. Groups are
+			// left out: deleting removes actors from their group
+			TArray<AActor*> Pending;
+			for (TActorIterator<AActor> It(&World); It; ++It)
+			{
+				if (!Doomed.Contains(*It) && !It->IsA<AGroupActor>())
+				{
+					Pending.Add(*It);
+				}
+			}
+
+			const auto CollectReferences = [&](const AActor* Referencer, const FString& ReferencerName)
+			{
+				for (UObject* Reference : References)
+				{
+					AActor* Referenced = Cast<AActor>(Reference);
+					if (const UActorComponent* Component = Cast<UActorComponent>(Reference))
+					{
+						// An attach parent lists its children; that link does not keep a child alive
+						const USceneComponent* SceneComponent = Cast<USceneComponent>(Component);
+						const USceneComponent* AttachParent = SceneComponent ? SceneComponent->GetAttachParent() : nullptr;
+						if (Referencer && AttachParent && AttachParent->GetOwner() == Referencer)
+						{
+							continue;
+						}
+						Referenced = Component->GetOwner();
+					}
+
+					if (!Referenced || Referenced == Referencer)
+					{
+						continue;
+					}
+					if (Doomed.Remove(Referenced) > 0)
+					{
+						OutReferencers.Add(Referenced);
+						if (!Referenced->IsA<AGroupActor>())
+						{
+							Pending.Add(Referenced);
+						}
+					}
+					if (TArray<FString>* Referencers = OutReferencers.Find(Referenced))
+					{
+						Referencers->AddUnique(ReferencerName);
+					}
+				}
+				References.Reset();
+			};
+
+			// 1. Level blueprint graphs (actor references and bound events), which always stay
+			for (ULevel* Level : World.GetLevels())
+			{
+				ULevelScriptBlueprint* Blueprint = Level ? Level->GetLevelScriptBlueprint(true) : nullptr;
+				if (!Blueprint)
+				{
+					continue;
+				}
+
+				TArray<UEdGraphNode*> Nodes;
+				FBlueprintEditorUtils::GetAllNodesOfClass(Blueprint, Nodes);
+				for (UEdGraphNode* Node : Nodes)
+				{
+					Finder.FindReferences(Node);
+				}
+				CollectReferences(nullptr, Blueprint->GetName());
+			}
+
+			// 2. Actors that stay, with their components, including the ones dropped along the way
+			while (Pending.Num() > 0)
+			{
+				AActor* Actor = Pending.Pop(EAllowShrinking::No);
+				Finder.FindReferences(Actor);
+				Actor->ForEachComponent(false, [&Finder](UActorComponent* Component)
+				{
+					Finder.FindReferences(Component);
+				});
+				CollectReferences(Actor, Actor->GetActorLabel());
+			}
+		}
+
+		void DeleteActor(AActor& Actor)
+		{
+			UWorld* World = Actor.GetWorld();
+			ULevel* Level = Actor.GetLevel();
+			if (!World || !Level)
+			{
+				return;
+			}
+
+			// Each level is recorded in the transaction once, not once per actor
+			bool bLevelModified = false;
+			ModifiedLevels.Add(Level, &bLevelModified);
+			if (!bLevelModified)
+			{
+				Level->Modify();
+			}
+
+			Actor.Modify();
+			if (ULayersSubsystem* Layers = GEditor->GetEditorSubsystem<ULayersSubsystem>())
+			{
+				Layers->DisassociateActorFromLayers(&Actor);
+			}
+			if (AGroupActor* Group = AGroupActor::GetParentForActor(&Actor))
+			{
+				Group->Remove(Actor);
+			}
+
+			if (World->EditorDestroyActor(&Actor, false))
+			{
+				++Response.deleted;
+				++NumPendingNotify;
+			}
+		}
+
+		// One outliner, property window and viewport refresh for every actor deleted since the last one
+		void NotifyDeleted()
+		{
+			if (NumPendingNotify == 0)
+			{
+				return;
+			}
+			NumPendingNotify = 0;
+
+			if (GEngine)
+			{
+				GEngine->BroadcastLevelActorListChanged();
+			}
+			FEditorSupportDelegates::RefreshPropertyWindows.Broadcast();
+			FEditorSupportDelegates::UpdateUI.Broadcast();
+			if (GEditor)
+			{
+				GEditor->RedrawLevelEditingViewports();
+			}
+		}
+
+		// Actors to delete, in selection order
+		TArray<TWeakObjectPtr<AActor>> Actors;
+		bool bResolved = false;
+		int32 NextIndex = 0;
+
+		TSet<TWeakObjectPtr<ULevel>> ModifiedLevels;
+		int32 NumPendingNotify = 0;
+	};
+}
+
+TUniquePtr<IEditorCommandTask> FDeleteActorsCommand::BeginWithParams(const FDeleteActorsCommandParams& Params)
+{
+	return MakeUnique<FDeleteActorsTask>(Params);
+}
+
+#undef LOCTEXT_NAMESPACE
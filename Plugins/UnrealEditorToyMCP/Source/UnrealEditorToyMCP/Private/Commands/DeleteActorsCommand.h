@@ -0,0 +1,32 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EditorCommandParams.h"
+
+/**
+ * DeleteActors command - Deletes many actors in one request
+ * References to the selected actors (or their components) are looked up in the rest of the world
+ * and the level blueprints; referenced actors are skipped (and reported) unless force is set, and
+ * their own references are checked in turn, since they stay in the level. The others
+ * are deleted in strides across frames inside one undo transaction, with the selection, outliner
+ * and viewports updated once for the whole batch.
+ * Parameters:
+ *   - ids / selector (one or the other): Actor GUIDs, or a non-empty actor filter (see FActorSelection)
+ *   - force (optional): Delete referenced actors as well
+ */
+class FDeleteActorsCommand : public TTypedEditorCommand<FDeleteActorsCommandParams>
+{
+public:
+	virtual ~FDeleteActorsCommand() override = default;
+
+	// IEditorCommand interface
+	virtual FString GetName() const override;
+	virtual FString GetDescription() const override;
+	virtual EEditorCommandPriority GetPriority() const override { return EEditorCommandPriority::Bulk; }
+
+protected:
+	// TTypedEditorCommand interface
+	virtual TUniquePtr<IEditorCommandTask> BeginWithParams(const FDeleteActorsCommandParams& Params) override;
+};
@@ -0,0 +1,104 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "EditorCommandParams.h"
+#include "JsonObjectConverter.h"
+#include "UObject/UnrealType.h"
+
+namespace
+{
+	const FName RequiredMetaDataKey(TEXT("MCPRequired"));
+
+	FString GetParameterType(const FProperty* Property)
+	{
+		if (Property->IsA<FStrProperty>() || Property->IsA<FNameProperty>() || Property->IsA<FTextProperty>() ||
+			Property->IsA<FEnumProperty>())
+		{
+			return TEXT("string");
+		}
+		if (Property->IsA<FBoolProperty>())
+		{
+			return TEXT("boolean");
+		}
+		if (const FNumericProperty* NumericProperty = CastField<FNumericProperty>(Property))
+		{
+			if (NumericProperty->IsEnum())
+			{
+				return TEXT("string");
+			}
+			return NumericProperty->IsInteger() ? TEXT("integer") : TEXT("number");
+		}
+		if (Property->IsA<FArrayProperty>() || Property->IsA<FSetProperty>())
+		{
+			return TEXT("array");
+		}
+		return TEXT("object");
+	}
+}
+
+TArray<FCommandParameter> FEditorCommandParams::BuildParameters(const UScriptStruct* ParamsStruct)
+{
+	TArray<FCommandParameter> Parameters;
+	if (!ParamsStruct)
+	{
+		return Parameters;
+	}
+
+	for (TFieldIterator<FProperty> It(ParamsStruct); It; ++It)
+	{
+		const FProperty* Property = *It;
+		Parameters.Add(FCommandParameter(
+			Property->GetName(),
+			GetParameterType(Property),
+			Property->HasMetaData(RequiredMetaDataKey),
+			Property->GetToolTipText().ToString()
+		));
+	}
+
+	return Parameters;
+}
+
+bool FEditorCommandParams::Decode(const TSharedPtr<FJsonObject>& Params, const UScriptStruct* ParamsStruct,
+                                  FInstancedStruct& OutParams, FString& OutError)
+{
+	OutParams.InitializeAs(ParamsStruct);
+
+	const TSharedRef<FJsonObject> ParamsObject = Params.IsValid() ? Params.ToSharedRef() : MakeShared<FJsonObject>();
+	if (!FJsonObjectConverter::JsonObjectToUStruct(ParamsObject, ParamsStruct, OutParams.GetMutableMemory()))
+	{
+		OutError = TEXT("Invalid parameters");
+		return false;
+	}
+
+	// Required fields must be present (and non-empty for strings)
+	TArray<FString> MissingFields;
+	for (TFieldIterator<FProperty> It(ParamsStruct); It; ++It)
+	{
+		const FProperty* Property = *It;
+		if (!Property->HasMetaData(RequiredMetaDataKey))
+		{
+			continue;
+		}
+
+		bool bPresent = ParamsObject->HasField(Property->GetName());
+		if (bPresent)
+		{
+			if (const FStrProperty* StrProperty = CastField<FStrProperty>(Property))
+			{
+				bPresent = !StrProperty->GetPropertyValue_InContainer(OutParams.GetMemory()).IsEmpty();
+			}
+		}
+
+		if (!bPresent)
+		{
+			MissingFields.Add(FString::Printf(TEXT("'%s'"), *Property->GetName()));
+		}
+	}
+
+	if (MissingFields.Num() > 0)
+	{
+		OutError = FString::Printf(TEXT("Missing or empty required parameter(s): %s"), *FString::Join(MissingFields, TEXT(", ")));
+		return false;
+	}
+
+	return true;
+}
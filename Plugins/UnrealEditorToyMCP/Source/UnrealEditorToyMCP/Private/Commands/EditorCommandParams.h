@@ -0,0 +1,119 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "IEditorCommand.h"
+#include "MCPJsonStructs.h"
+
+/**
+ * Reflection helpers for command params USTRUCTs
+ * Each UPROPERTY of a params struct is one command parameter:
+ *   - name: property name (matched case-insensitively against JSON keys)
+ *   - type: derived from the property type (string, boolean, integer, number, array, object)
+ *   - required: set with meta = (MCPRequired); strings must also be non-empty
+ *   - description: the property's doc comment (tooltip)
+ */
+class FEditorCommandParams
+{
+public:
+	/**
+	 * Build parameter definitions from a params struct
+	 * @param ParamsStruct Params USTRUCT
+	 * @return Array of parameter definitions
+	 */
+	static TArray<FCommandParameter> BuildParameters(const UScriptStruct* ParamsStruct);
+
+	/**
+	 * Decode and validate JSON params into a params struct
+	 * Safe to call from any thread
+	 * @param Params JSON object containing command parameters (may be null)
+	 * @param ParamsStruct Params USTRUCT to decode into
+	 * @param OutParams Decoded params struct
+	 * @param OutError Error message when decoding or validation fails
+	 * @return True if the params were decoded and every required field is present
+	 */
+	static bool Decode(const TSharedPtr<FJsonObject>& Params, const UScriptStruct* ParamsStruct,
+	                   FInstancedStruct& OutParams, FString& OutError);
+};
+
+/**
+ * Base class for commands that declare a params USTRUCT
+ * The parameter schema is generated from the struct, and the dispatch layer hands the
+ * already decoded struct to ExecuteWithParams.
+ */
+template<typename ParamsStructType>
+class TTypedEditorCommand : public IEditorCommand
+{
+public:
+	// IEditorCommand interface
+	virtual TArray<FCommandParameter> GetParameters() const override
+	{
+		return FEditorCommandParams::BuildParameters(ParamsStructType::StaticStruct());
+	}
+
+	virtual const UScriptStruct* GetParamsStruct() const override
+	{
+		return ParamsStructType::StaticStruct();
+	}
+
+	virtual FEditorCommandResult Execute(const TSharedPtr<FJsonObject>& Params) override
+	{
+		// Untyped entry point: decode here when the caller did not
+		FInstancedStruct TypedParams;
+		FString Error;
+		if (!DecodeParams(Params, TypedParams, Error))
+		{
+			FMCPErrorResponse ErrorResponse;
+			ErrorResponse.error = Error;
+			return FEditorCommandResult::Make(MoveTemp(ErrorResponse));
+		}
+
+		return ExecuteTyped(TypedParams);
+	}
+
+	virtual FEditorCommandResult ExecuteTyped(const FInstancedStruct& Params) override
+	{
+		return ExecuteWithParams(Params.Get<ParamsStructType>());
+	}
+
+	virtual TUniquePtr<IEditorCommandTask> Begin(const TArray<FEditorCommandInvocation>& Invocations) override
+	{
+		// Only single invocations with decoded params are resumable; anything else runs through Execute
+		if (Invocations.Num() != 1 || !Invocations[0].TypedParams)
+		{
+			return nullptr;
+		}
+		return BeginWithParams(Invocations[0].TypedParams->Get<ParamsStructType>());
+	}
+
+protected:
+	/**
+	 * Execute the command with decoded params
+	 * By default, synchronous callers run the resumable task from BeginWithParams to completion in one go.
+	 * @param Params Decoded and validated params struct
+	 * @return Command result (response USTRUCT)
+	 */
+	virtual FEditorCommandResult ExecuteWithParams(const ParamsStructType& Params)
+	{
+		const TUniquePtr<IEditorCommandTask> Task = BeginWithParams(Params);
+		if (!Task)
+		{
+			FMCPErrorResponse ErrorResponse;
+			ErrorResponse.error = TEXT("Command has no implementation");
+			return FEditorCommandResult::Make(MoveTemp(ErrorResponse));
+		}
+
+		while (Task->Step(TNumericLimits<double>::Max()) == EEditorCommandStepResult::Continue)
+		{
+		}
+		return Task->Finish()[0];
+	}
+
+	/**
+	 * Start a resumable execution with decoded params
+	 * @param Params Decoded and validated params struct (valid until the task has finished)
+	 * @return Task to step, or nullptr to run ExecuteWithParams in a single call instead
+	 */
+	virtual TUniquePtr<IEditorCommandTask> BeginWithParams(const ParamsStructType& Params) { return nullptr; }
+};
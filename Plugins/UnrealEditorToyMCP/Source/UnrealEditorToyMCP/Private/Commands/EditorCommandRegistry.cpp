@@ -1,48 +1,53 @@
 // Fill out your copyright notice in the Description page of Project Settings.
 
 #include "EditorCommandRegistry.h"
+#include "MCPJsonHelpers.h"
+#include "UnrealEditorMCP.h"
 
 FEditorCommandRegistry::FEditorCommandRegistry()
+	: ResultCache(MakeShared<FEditorCommandResultCache>())
 {
 }
 
 FEditorCommandRegistry::~FEditorCommandRegistry()
 {
 	Commands.Empty();
+	CommandList.Empty();
+	ToolInfos.Empty();
 }
 
 void FEditorCommandRegistry::RegisterCommand(TSharedPtr<IEditorCommand> Command)
 {
 	if (!Command.IsValid())
 	{
-		UE_LOG(LogTemp, Warning, TEXT("UnrealEditorMCP: Attempted to register invalid command"));
+		UE_LOG(LogUnrealEditorMCP, Warning, TEXT("UnrealEditorMCP: Attempted to register invalid command"));
 		return;
 	}
 
-	const FString CommandName = Command->GetName();
-	if (Commands.Contains(CommandName))
+	const FName CommandName(*Command->GetName());
+	if (const TSharedPtr<IEditorCommand>* Existing = Commands.Find(CommandName))
 	{
-		UE_LOG(LogTemp, Warning, TEXT("UnrealEditorMCP: Command '%s' is already registered, overwriting"), *CommandName);
+		UE_LOG(LogUnrealEditorMCP, Warning, TEXT("UnrealEditorMCP: Command '%s' is already registered, overwriting"), *CommandName.ToString());
+		const int32 ExistingIndex = CommandList.IndexOfByKey(*Existing);
+		CommandList.RemoveAt(ExistingIndex);
+		ToolInfos.RemoveAt(ExistingIndex);
 	}
 
 	Commands.Add(CommandName, Command);
-	UE_LOG(LogTemp, Display, TEXT("UnrealEditorMCP: Registered command '%s'"), *CommandName);
+	CommandList.Add(Command);
+
+	// Generate the schema once; GetParameters is not called again
+	ToolInfos.Add(FMCPJsonHelpers::CommandToToolInfo(Command, true));
+	UE_LOG(LogUnrealEditorMCP, Display, TEXT("UnrealEditorMCP: Registered command '%s'"), *CommandName.ToString());
 }
 
-TSharedPtr<IEditorCommand> FEditorCommandRegistry::GetCommand(const FString& CommandName) const
+TSharedPtr<IEditorCommand> FEditorCommandRegistry::GetCommand(const FName CommandName) const
 {
 	const TSharedPtr<IEditorCommand>* FoundCommand = Commands.Find(CommandName);
 	return FoundCommand ? *FoundCommand : nullptr;
 }
 
-TArray<TSharedPtr<IEditorCommand>> FEditorCommandRegistry::GetAllCommands() const
-{
-	TArray<TSharedPtr<IEditorCommand>> CommandArray;
-	Commands.GenerateValueArray(CommandArray);
-	return CommandArray;
-}
-
-bool FEditorCommandRegistry::HasCommand(const FString& CommandName) const
+bool FEditorCommandRegistry::HasCommand(const FName CommandName) const
 {
 	return Commands.Contains(CommandName);
 }
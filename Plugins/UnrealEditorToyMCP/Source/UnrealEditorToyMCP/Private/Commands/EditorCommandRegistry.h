@@ -4,10 +4,15 @@
 
 #include "CoreMinimal.h"
 #include "IEditorCommand.h"
+#include "EditorCommandResultCache.h"
+#include "MCPJsonStructs.h"
 
 /**
  * Registry for editor commands
  * Manages command registration and lookup using the Registry pattern
+ * Commands are keyed by FName, so lookups hash an index instead of a case-insensitive string.
+ * The registry is filled once at startup and treated as immutable afterwards; the HTTP server
+ * resolves each command once and binds a dedicated route to it.
  */
 class FEditorCommandRegistry
 {
@@ -26,20 +31,27 @@ public:
 	 * @param CommandName Name of the command to retrieve
 	 * @return Shared pointer to the command, or nullptr if not found
 	 */
-	TSharedPtr<IEditorCommand> GetCommand(const FString& CommandName) const;
+	TSharedPtr<IEditorCommand> GetCommand(FName CommandName) const;
 
 	/**
 	 * Get all registered commands
 	 * @return Array of all command instances
 	 */
-	TArray<TSharedPtr<IEditorCommand>> GetAllCommands() const;
+	const TArray<TSharedPtr<IEditorCommand>>& GetAllCommands() const { return CommandList; }
+
+	/**
+	 * Get the tool schema of all registered commands
+	 * Built once at registration, in the same order as GetAllCommands
+	 * @return Array of tool information including parameters
+	 */
+	const TArray<FMCPToolInfo>& GetToolInfos() const { return ToolInfos; }
 
 	/**
 	 * Check if a command exists
 	 * @param CommandName Name of the command to check
 	 * @return True if command exists, false otherwise
 	 */
-	bool HasCommand(const FString& CommandName) const;
+	bool HasCommand(FName CommandName) const;
 
 	/**
 	 * Get the number of registered commands
@@ -47,7 +59,22 @@ public:
 	 */
 	int32 GetCommandCount() const;
 
+	/**
+	 * Get the result cache used when dispatching cacheable commands
+	 * @return Shared reference to the result cache
+	 */
+	TSharedRef<FEditorCommandResultCache> GetResultCache() const { return ResultCache; }
+
 private:
 	// Command storage: CommandName -> Command instance
-	TMap<FString, TSharedPtr<IEditorCommand>> Commands;
+	TMap<FName, TSharedPtr<IEditorCommand>> Commands;
+
+	// Commands in registration order (for tool lists and route binding)
+	TArray<TSharedPtr<IEditorCommand>> CommandList;
+
+	// Tool schema per command (parallel to CommandList)
+	TArray<FMCPToolInfo> ToolInfos;
+
+	// Serialized responses of cacheable commands
+	TSharedRef<FEditorCommandResultCache> ResultCache;
 };
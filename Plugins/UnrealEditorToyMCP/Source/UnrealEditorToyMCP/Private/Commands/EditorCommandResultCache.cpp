@@ -0,0 +1,209 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "EditorCommandResultCache.h"
+#include "Editor.h"
+#include "Editor/TransBuffer.h"
+#include "Engine/Engine.h"
+#include "UObject/ObjectSaveContext.h"
+#include "UObject/Package.h"
+
+namespace
+{
+	// Append a JSON value with object keys sorted, so equal params always produce the same key
+	void AppendCanonicalJson(const TSharedPtr<FJsonValue>& Value, FString& Out)
+	{
+		if (!Value.IsValid())
+		{
+			Out += TEXT("null");
+			return;
+		}
+
+		switch (Value->Type)
+		{
+		case EJson::String:
+			Out += TEXT("\"") + Value->AsString().ReplaceCharWithEscapedChar() + TEXT("\"");
+			break;
+		case EJson::Number:
+			Out += FString::SanitizeFloat(Value->AsNumber());
+			break;
+		case EJson::Boolean:
+			Out += Value->AsBool() ? TEXT("true") : TEXT("false");
+			break;
+		case EJson::Array:
+			{
+				Out += TEXT("[");
+				bool bFirst = true;
+				for (const TSharedPtr<FJsonValue>& Element : Value->AsArray())
+				{
+					if (!bFirst) Out += TEXT(",");
+					AppendCanonicalJson(Element, Out);
+					bFirst = false;
+				}
+				Out += TEXT("]");
+				break;
+			}
+		case EJson::Object:
+			{
+				const TSharedPtr<FJsonObject>& Object = Value->AsObject();
+				TArray<FString> Keys;
+				Object->Values.GetKeys(Keys);
+				Keys.Sort();
+
+				Out += TEXT("{");
+				bool bFirst = true;
+				for (const FString& Key : Keys)
+				{
+					if (!bFirst) Out += TEXT(",");
+					Out += TEXT("\"") + Key.ReplaceCharWithEscapedChar() + TEXT("\":");
+					AppendCanonicalJson(Object->Values[Key], Out);
+					bFirst = false;
+				}
+				Out += TEXT("}");
+				break;
+			}
+		default:
+			Out += TEXT("null");
+			break;
+		}
+	}
+}
+
+FEditorCommandResultCache::FEditorCommandResultCache()
+{
+	FEditorDelegates::PostUndoRedo.AddRaw(this, &FEditorCommandResultCache::HandlePostUndoRedo);
+	FEditorDelegates::MapChange.AddRaw(this, &FEditorCommandResultCache::HandleMapChange);
+	FEditorDelegates::OnMapOpened.AddRaw(this, &FEditorCommandResultCache::HandleMapOpened);
+	UPackage::PackageSavedWithContextEvent.AddRaw(this, &FEditorCommandResultCache::HandlePackageSaved);
+	FCoreUObjectDelegates::OnObjectPropertyChanged.AddRaw(this, &FEditorCommandResultCache::HandleObjectPropertyChanged);
+
+	if (GEditor)
+	{
+		if (UTransBuffer* TransBuffer = Cast<UTransBuffer>(GEditor->Trans))
+		{
+			TransBuffer->OnTransactionStateChanged().AddRaw(this, &FEditorCommandResultCache::HandleTransactionStateChanged);
+		}
+	}
+
+	if (GEngine)
+	{
+		GEngine->OnLevelActorAdded().AddRaw(this, &FEditorCommandResultCache::HandleActorChanged);
+		GEngine->OnLevelActorDeleted().AddRaw(this, &FEditorCommandResultCache::HandleActorChanged);
+		GEngine->OnActorMoved().AddRaw(this, &FEditorCommandResultCache::HandleActorChanged);
+	}
+}
+
+FEditorCommandResultCache::~FEditorCommandResultCache()
+{
+	FEditorDelegates::PostUndoRedo.RemoveAll(this);
+	FEditorDelegates::MapChange.RemoveAll(this);
+	FEditorDelegates::OnMapOpened.RemoveAll(this);
+	UPackage::PackageSavedWithContextEvent.RemoveAll(this);
+	FCoreUObjectDelegates::OnObjectPropertyChanged.RemoveAll(this);
+
+	if (GEditor)
+	{
+		if (UTransBuffer* TransBuffer = Cast<UTransBuffer>(GEditor->Trans))
+		{
+			TransBuffer->OnTransactionStateChanged().RemoveAll(this);
+		}
+	}
+
+	if (GEngine)
+	{
+		GEngine->OnLevelActorAdded().RemoveAll(this);
+		GEngine->OnLevelActorDeleted().RemoveAll(this);
+		GEngine->OnActorMoved().RemoveAll(this);
+	}
+}
+
+FString FEditorCommandResultCache::MakeKey(const FString& CommandName, const TSharedPtr<FJsonObject>& Params)
+{
+	FString Key = CommandName + TEXT("|");
+	AppendCanonicalJson(Params.IsValid() ? MakeShared<FJsonValueObject>(Params) : nullptr, Key);
+	return Key;
+}
+
+bool FEditorCommandResultCache::Find(const FString& Key, TArray<uint8>& OutBody) const
+{
+	FScopeLock Lock(&EntriesLock);
+
+	const FCacheEntry* Entry = Entries.Find(Key);
+	if (!Entry || Entry->Revision != GetRevision())
+	{
+		return false;
+	}
+
+	OutBody = Entry->Body;
+	return true;
+}
+
+void FEditorCommandResultCache::Store(const FString& Key, const uint64 InRevision, const TArray<uint8>& Body)
+{
+	FScopeLock Lock(&EntriesLock);
+
+	// The editor changed while the command was in flight; the result may already be stale
+	if (InRevision != GetRevision())
+	{
+		return;
+	}
+
+	if (Entries.Num() >= MaxEntries && !Entries.Contains(Key))
+	{
+		Entries.Empty();
+	}
+
+	FCacheEntry& Entry = Entries.FindOrAdd(Key);
+	Entry.Revision = InRevision;
+	Entry.Body = Body;
+}
+
+void FEditorCommandResultCache::Invalidate()
+{
+	FScopeLock Lock(&EntriesLock);
+
+	++Revision;
+	if (Entries.Num() > 0)
+	{
+		Entries.Empty();
+	}
+}
+
+void FEditorCommandResultCache::HandlePostUndoRedo()
+{
+	Invalidate();
+}
+
+void FEditorCommandResultCache::HandleTransactionStateChanged(const FTransactionContext& TransactionContext,
+                                                              const ETransactionStateEventType TransactionState)
+{
+	if (TransactionState == ETransactionStateEventType::TransactionFinalized ||
+		TransactionState == ETransactionStateEventType::UndoRedoFinalized)
+	{
+		Invalidate();
+	}
+}
+
+void FEditorCommandResultCache::HandleMapChange(uint32 MapChangeFlags)
+{
+	Invalidate();
+}
+
+void FEditorCommandResultCache::HandleMapOpened(const FString& Filename, bool bAsTemplate)
+{
+	Invalidate();
+}
+
+void FEditorCommandResultCache::HandlePackageSaved(const FString& PackageFilename, UPackage* Package, FObjectPostSaveContext SaveContext)
+{
+	Invalidate();
+}
+
+void FEditorCommandResultCache::HandleActorChanged(AActor* Actor)
+{
+	Invalidate();
+}
+
+void FEditorCommandResultCache::HandleObjectPropertyChanged(UObject* Object, FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Invalidate();
+}
@@ -0,0 +1,85 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+#include "Misc/ITransaction.h"
+#include <atomic>
+
+class AActor;
+class UPackage;
+class FObjectPostSaveContext;
+struct FPropertyChangedEvent;
+
+/**
+ * Cache of serialized responses for read-only (cacheable) commands
+ * Entries are keyed by command name + canonical params and tagged with the editor revision
+ * they were produced at. The revision is bumped by undo/redo, transactions, map changes,
+ * asset saves, actor edits and by every command that modifies the editor, which makes older entries miss.
+ * Lookups and stores are thread-safe; delegates are registered on the game thread.
+ */
+class FEditorCommandResultCache
+{
+public:
+	FEditorCommandResultCache();
+	~FEditorCommandResultCache();
+
+	/**
+	 * Build the cache key for a command invocation
+	 * @param CommandName Name of the command
+	 * @param Params JSON object containing command parameters (may be null)
+	 * @return Key made of the command name and canonical (key-sorted) params
+	 */
+	static FString MakeKey(const FString& CommandName, const TSharedPtr<FJsonObject>& Params);
+
+	/**
+	 * Get the current editor revision
+	 * @return Revision counter, bumped on every invalidation
+	 */
+	uint64 GetRevision() const { return Revision.load(); }
+
+	/**
+	 * Look up a cached response body
+	 * @param Key Cache key from MakeKey
+	 * @param OutBody Serialized response body on hit
+	 * @return True if an entry exists for the current revision
+	 */
+	bool Find(const FString& Key, TArray<uint8>& OutBody) const;
+
+	/**
+	 * Store a serialized response body
+	 * Entries produced at an older revision than the current one are dropped.
+	 * @param Key Cache key from MakeKey
+	 * @param InRevision Revision read before the command was executed
+	 * @param Body Serialized response body
+	 */
+	void Store(const FString& Key, uint64 InRevision, const TArray<uint8>& Body);
+
+	/** Bump the revision and drop every entry */
+	void Invalidate();
+
+private:
+	// Editor change handlers (all invalidate the cache)
+	void HandlePostUndoRedo();
+	void HandleTransactionStateChanged(const FTransactionContext& TransactionContext, ETransactionStateEventType TransactionState);
+	void HandleMapChange(uint32 MapChangeFlags);
+	void HandleMapOpened(const FString& Filename, bool bAsTemplate);
+	void HandlePackageSaved(const FString& PackageFilename, UPackage* Package, FObjectPostSaveContext SaveContext);
+	void HandleActorChanged(AActor* Actor);
+	void HandleObjectPropertyChanged(UObject* Object, FPropertyChangedEvent& PropertyChangedEvent);
+
+	struct FCacheEntry
+	{
+		uint64 Revision = 0;
+		TArray<uint8> Body;
+	};
+
+	// Maximum number of cached responses (the cache is cleared when exceeded)
+	static constexpr int32 MaxEntries = 256;
+
+	std::atomic<uint64> Revision{1};
+
+	mutable FCriticalSection EntriesLock;
+	TMap<FString, FCacheEntry> Entries;
+};
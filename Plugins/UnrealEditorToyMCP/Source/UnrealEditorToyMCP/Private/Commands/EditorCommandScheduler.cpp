@@ -0,0 +1,578 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "EditorCommandScheduler.h"
+#include "EditorCommandResultCache.h"
+#include "MCPJsonHelpers.h"
+#include "MCPTrace.h"
+#include "MCPWorldSnapshot.h"
+#include "Async/Async.h"
+#include "HAL/IConsoleManager.h"
+#include "JsonObjectConverter.h"
+
+static TAutoConsoleVariable<float> CVarMCPSchedulerFrameBudgetMs(
+	TEXT("mcp.Scheduler.FrameBudgetMs"),
+	8.0f,
+	TEXT("Game thread time per frame for interactive and bulk MCP commands. At least one command runs per frame; control commands are not limited."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarMCPSchedulerInteractiveWeight(
+	TEXT("mcp.Scheduler.InteractiveWeight"),
+	4,
+	TEXT("Share of executions given to interactive MCP commands relative to bulk commands."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarMCPSchedulerBulkWeight(
+	TEXT("mcp.Scheduler.BulkWeight"),
+	1,
+	TEXT("Share of executions given to bulk MCP commands relative to interactive commands."),
+	ECVF_Default);
+
+namespace
+{
+	// Move the leading requests of a session that target Command into Group
+	void TakeLeadingRun(TArray<FEditorCommandRequest>& Requests, const IEditorCommand* Command,
+	                    TArray<FEditorCommandRequest>& Group)
+	{
+		int32 Count = 0;
+		while (Count < Requests.Num() && Requests[Count].Command == Command)
+		{
+			Group.Add(MoveTemp(Requests[Count]));
+			++Count;
+		}
+		Requests.RemoveAt(0, Count);
+	}
+}
+
+FEditorCommandScheduler::FEditorCommandScheduler(const TSharedRef<FEditorCommandResultCache>& InResultCache,
+                                                 const TSharedRef<FMCPMetrics>& InMetrics,
+                                                 const TSharedRef<FMCPWorldSnapshotBuilder>& InWorldSnapshot)
+	: ResultCache(InResultCache)
+	  , WorldSnapshot(InWorldSnapshot)
+	  , Metrics(InMetrics)
+{
+	TickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+		FTickerDelegate::CreateRaw(this, &FEditorCommandScheduler::Tick));
+}
+
+FEditorCommandScheduler::~FEditorCommandScheduler()
+{
+	FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+	CancelPendingRequests();
+}
+
+void FEditorCommandScheduler::Enqueue(FEditorCommandRequest&& Request)
+{
+	Request.Timing.EnqueuedTime = FPlatformTime::Seconds();
+	if (Request.Command->ModifiesEditor())
+	{
+		NumPendingWrites.fetch_add(1, std::memory_order_acq_rel);
+	}
+	IncomingRequests[static_cast<int32>(Request.Priority)].Enqueue(MoveTemp(Request));
+}
+
+void FEditorCommandScheduler::ExecuteOnSnapshot(FEditorCommandRequest&& Request, const TSharedRef<const IEditorCommand>& Command,
+                                                const TSharedRef<const FMCPWorldSnapshot>& Snapshot)
+{
+	Request.Timing.EnqueuedTime = FPlatformTime::Seconds();
+
+	// Snapshot results are never cached: a newer live result may already be stored under the same key
+	Request.CacheKey.Reset();
+
+	AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask,
+	          [Request = MoveTemp(Request), Command, Snapshot, ResultCache = ResultCache, Metrics = Metrics]() mutable
+	          {
+		          Request.Timing.DequeuedTime = FPlatformTime::Seconds();
+		          Request.Timing.ExecuteStartTime = Request.Timing.DequeuedTime;
+
+		          FEditorCommandResult Result;
+		          {
+			          MCP_TRACE_REQUEST_SCOPE("Snapshot", *Command, Request.RequestId);
+			          const FEditorCommandInvocation Invocation{Request.Params, Request.TypedParams.IsValid() ? &Request.TypedParams : nullptr};
+			          Result = Command->ExecuteOnSnapshot(*Snapshot, Invocation);
+		          }
+
+		          Request.Timing.ExecuteEndTime = FPlatformTime::Seconds();
+		          CompleteRequest(Request, &Result, *ResultCache, *Metrics);
+	          });
+}
+
+bool FEditorCommandScheduler::HasPendingWork() const
+{
+	for (int32 LaneIndex = 0; LaneIndex < NumLanes; ++LaneIndex)
+	{
+		if (Lanes[LaneIndex].HasWork() || !IncomingRequests[LaneIndex].IsEmpty())
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+bool FEditorCommandScheduler::Tick(float DeltaTime)
+{
+	// Reported in /mcp/status; drops sharply when the editor throttles itself in the background
+	constexpr float TickRateSmoothing = 0.1f;
+	AverageDeltaTime = AverageDeltaTime > 0.0f ? FMath::Lerp(AverageDeltaTime, DeltaTime, TickRateSmoothing) : DeltaTime;
+
+	// 1. Move everything queued since the last frame into the lanes
+	DrainIncoming();
+
+	bool bHasWork = false;
+	for (const FLane& Lane : Lanes)
+	{
+		bHasWork |= Lane.HasWork();
+	}
+	if (!bHasWork)
+	{
+		return true;
+	}
+
+	const double FrameStartTime = FPlatformTime::Seconds();
+
+	const double BudgetSeconds = CVarMCPSchedulerFrameBudgetMs.GetValueOnGameThread() / 1000.0;
+
+	// 2. Control requests never wait behind other work
+	FLane& ControlLane = Lanes[static_cast<int32>(EEditorCommandPriority::Control)];
+	while (ControlLane.HasWork())
+	{
+		ExecuteNext(ControlLane, BudgetSeconds);
+	}
+
+	// 3. Interactive and bulk requests share the frame budget by weight. The budget is checked after
+	//    each execution, so every frame makes progress even when a single command exceeds it.
+	const double InteractiveStartTime = FPlatformTime::Seconds();
+	for (int32 LaneIndex = PickWeightedLane(); LaneIndex != INDEX_NONE; LaneIndex = PickWeightedLane())
+	{
+		const double RemainingSeconds = BudgetSeconds - (FPlatformTime::Seconds() - InteractiveStartTime);
+		ExecuteNext(Lanes[LaneIndex], FMath::Max(RemainingSeconds, 0.0));
+
+		if (FPlatformTime::Seconds() - InteractiveStartTime >= BudgetSeconds)
+		{
+			break;
+		}
+	}
+
+	Metrics->AddGameThreadTime(FPlatformTime::Seconds() - FrameStartTime);
+	return true;
+}
+
+void FEditorCommandScheduler::DrainIncoming()
+{
+	MCP_TRACE_SCOPE("MCP Dequeue");
+
+	const double DequeuedTime = FPlatformTime::Seconds();
+	for (int32 LaneIndex = 0; LaneIndex < NumLanes; ++LaneIndex)
+	{
+		FLane& Lane = Lanes[LaneIndex];
+
+		FEditorCommandRequest Request;
+		while (IncomingRequests[LaneIndex].Dequeue(Request))
+		{
+			Request.Timing.DequeuedTime = DequeuedTime;
+
+			FSessionQueue* Session = Lane.Sessions.FindByPredicate([&Request](const FSessionQueue& Candidate)
+			{
+				return Candidate.SessionId == Request.SessionId;
+			});
+			if (!Session)
+			{
+				Session = &Lane.Sessions.AddDefaulted_GetRef();
+				Session->SessionId = Request.SessionId;
+			}
+
+			Session->Requests.Add(MoveTemp(Request));
+			++Lane.NumPending;
+		}
+	}
+}
+
+int32 FEditorCommandScheduler::PickWeightedLane()
+{
+	const int32 Weights[NumLanes] = {
+		0,
+		FMath::Max(CVarMCPSchedulerInteractiveWeight.GetValueOnGameThread(), 1),
+		FMath::Max(CVarMCPSchedulerBulkWeight.GetValueOnGameThread(), 1)
+	};
+
+	// Smooth weighted round-robin: every non-empty lane earns its weight, the richest lane runs
+	// and pays the total, which interleaves lanes instead of running them in bursts
+	int32 BestLane = INDEX_NONE;
+	int32 TotalWeight = 0;
+	for (int32 LaneIndex = static_cast<int32>(EEditorCommandPriority::Interactive); LaneIndex < NumLanes; ++LaneIndex)
+	{
+		FLane& Lane = Lanes[LaneIndex];
+		if (!Lane.HasWork())
+		{
+			Lane.Credit = 0;
+			continue;
+		}
+
+		Lane.Credit += Weights[LaneIndex];
+		TotalWeight += Weights[LaneIndex];
+		if (BestLane == INDEX_NONE || Lane.Credit > Lanes[BestLane].Credit)
+		{
+			BestLane = LaneIndex;
+		}
+	}
+
+	if (BestLane != INDEX_NONE)
+	{
+		Lanes[BestLane].Credit -= TotalWeight;
+	}
+	return BestLane;
+}
+
+void FEditorCommandScheduler::ExecuteNext(FLane& Lane, const double BudgetSeconds)
+{
+	// 1. A resumable command in progress keeps the lane until it is done or yields it
+	if (Lane.ActiveTask)
+	{
+		StepActiveTask(Lane, BudgetSeconds);
+		return;
+	}
+
+	// 2. Parked tasks take turns with new requests, so a long script never holds the lane
+	const int32 SessionIndex = FindNextSession(Lane);
+	if (!Lane.ParkedTasks.IsEmpty() && (SessionIndex == INDEX_NONE || Lane.bParkedTurn))
+	{
+		Lane.bParkedTurn = false;
+		StepParkedTask(Lane, BudgetSeconds);
+		return;
+	}
+	Lane.bParkedTurn = true;
+
+	// 3. Sessions take turns
+	FSessionQueue& Session = Lane.Sessions[SessionIndex];
+	IEditorCommand* Command = Session.Requests[0].Command;
+
+	// 4. Merge the leading run of a batchable command from every session of the lane. Only leading
+	//    runs are taken, so no request is answered with state from before a command its session
+	//    queued ahead of it.
+	TArray<FEditorCommandRequest> Group;
+	if (Command->SupportsBatchExecution())
+	{
+		TakeLeadingRun(Session.Requests, Command, Group);
+		for (FSessionQueue& OtherSession : Lane.Sessions)
+		{
+			if (&OtherSession != &Session && !IsSessionParked(Lane, OtherSession.SessionId))
+			{
+				TakeLeadingRun(OtherSession.Requests, Command, Group);
+			}
+		}
+	}
+	else
+	{
+		Group.Add(MoveTemp(Session.Requests[0]));
+		Session.Requests.RemoveAt(0);
+	}
+	Lane.NumPending -= Group.Num();
+
+	// 5. Drop drained sessions and advance the cursor past the session that just ran
+	Lane.NextSession = SessionIndex + 1;
+	for (int32 Index = Lane.Sessions.Num() - 1; Index >= 0; --Index)
+	{
+		if (Lane.Sessions[Index].Requests.IsEmpty())
+		{
+			Lane.Sessions.RemoveAt(Index);
+			if (Index < Lane.NextSession)
+			{
+				--Lane.NextSession;
+			}
+		}
+	}
+
+	StartGroup(Lane, *Command, MoveTemp(Group), BudgetSeconds);
+}
+
+int32 FEditorCommandScheduler::FindNextSession(const FLane& Lane)
+{
+	for (int32 Offset = 0; Offset < Lane.Sessions.Num(); ++Offset)
+	{
+		const int32 SessionIndex = (Lane.NextSession + Offset) % Lane.Sessions.Num();
+		if (!IsSessionParked(Lane, Lane.Sessions[SessionIndex].SessionId))
+		{
+			return SessionIndex;
+		}
+	}
+	return INDEX_NONE;
+}
+
+bool FEditorCommandScheduler::IsSessionParked(const FLane& Lane, const FString& SessionId)
+{
+	if (SessionId.IsEmpty())
+	{
+		return false;
+	}
+
+	for (const TUniquePtr<FActiveTask>& ParkedTask : Lane.ParkedTasks)
+	{
+		for (const FEditorCommandRequest& Request : ParkedTask->Requests)
+		{
+			if (Request.SessionId == SessionId)
+			{
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+void FEditorCommandScheduler::StartGroup(FLane& Lane, IEditorCommand& Command, TArray<FEditorCommandRequest>&& Group,
+                                         const double BudgetSeconds)
+{
+	const double ExecuteStartTime = FPlatformTime::Seconds();
+
+	// 1. Resumable commands: begin a task and take the first step right away
+	TUniquePtr<FActiveTask> ActiveTask = MakeUnique<FActiveTask>();
+	ActiveTask->Command = &Command;
+	ActiveTask->Requests = MoveTemp(Group);
+	ActiveTask->ExecuteStartTime = ExecuteStartTime;
+	ActiveTask->Invocations.Reserve(ActiveTask->Requests.Num());
+	for (const FEditorCommandRequest& Request : ActiveTask->Requests)
+	{
+		ActiveTask->Invocations.Add({Request.Params, Request.TypedParams.IsValid() ? &Request.TypedParams : nullptr});
+	}
+
+	{
+		MCP_TRACE_REQUEST_SCOPE("Begin", Command, ActiveTask->Requests[0].RequestId);
+		ActiveTask->Task = Command.Begin(ActiveTask->Invocations);
+	}
+
+	if (ActiveTask->Task)
+	{
+		Lane.ActiveTask = MoveTemp(ActiveTask);
+		StepActiveTask(Lane, BudgetSeconds);
+		return;
+	}
+
+	// 2. Everything else executes in a single call (one shared execution when more than one request is pending)
+	TArray<FEditorCommandResult> Results;
+	if (ActiveTask->Requests.Num() > 1)
+	{
+		// Tagged with the first request of the batch
+		MCP_TRACE_REQUEST_SCOPE("ExecuteBatch", Command, ActiveTask->Requests[0].RequestId);
+		Results = Command.ExecuteBatch(ActiveTask->Invocations);
+	}
+	else
+	{
+		const FEditorCommandRequest& Request = ActiveTask->Requests[0];
+		MCP_TRACE_REQUEST_SCOPE("Execute", Command, Request.RequestId);
+		Results.Add(Request.TypedParams.IsValid() ? Command.ExecuteTyped(Request.TypedParams) : Command.Execute(Request.Params));
+	}
+
+	CompleteGroup(Command, MoveTemp(ActiveTask->Requests), MoveTemp(Results), ExecuteStartTime);
+}
+
+void FEditorCommandScheduler::StepActiveTask(FLane& Lane, const double BudgetSeconds)
+{
+	if (StepTask(*Lane.ActiveTask, BudgetSeconds))
+	{
+		Lane.ActiveTask.Reset();
+	}
+	else if (Lane.ActiveTask->Task->YieldsLane())
+	{
+		Lane.ParkedTasks.Add(MoveTemp(Lane.ActiveTask));
+	}
+}
+
+void FEditorCommandScheduler::StepParkedTask(FLane& Lane, const double BudgetSeconds)
+{
+	const int32 TaskIndex = Lane.NextParkedTask % Lane.ParkedTasks.Num();
+	if (StepTask(*Lane.ParkedTasks[TaskIndex], BudgetSeconds))
+	{
+		// The cursor now points at the task after the finished one
+		Lane.ParkedTasks.RemoveAt(TaskIndex);
+		Lane.NextParkedTask = TaskIndex;
+	}
+	else
+	{
+		Lane.NextParkedTask = TaskIndex + 1;
+	}
+}
+
+bool FEditorCommandScheduler::StepTask(FActiveTask& ActiveTask, const double BudgetSeconds)
+{
+	IEditorCommand& Command = *ActiveTask.Command;
+
+	EEditorCommandStepResult StepResult;
+	{
+		MCP_TRACE_REQUEST_SCOPE("Step", Command, ActiveTask.Requests[0].RequestId);
+		StepResult = ActiveTask.Task->Step(BudgetSeconds);
+	}
+
+	// Partial edits are visible between steps, so cached reads must not outlive a step either
+	if (Command.ModifiesEditor())
+	{
+		ResultCache->Invalidate();
+	}
+
+	if (StepResult == EEditorCommandStepResult::Continue)
+	{
+		return false;
+	}
+
+	TArray<FEditorCommandResult> Results;
+	{
+		MCP_TRACE_REQUEST_SCOPE("Finish", Command, ActiveTask.Requests[0].RequestId);
+		Results = ActiveTask.Task->Finish();
+	}
+
+	CompleteGroup(Command, MoveTemp(ActiveTask.Requests), MoveTemp(Results), ActiveTask.ExecuteStartTime);
+	return true;
+}
+
+void FEditorCommandScheduler::CompleteGroup(IEditorCommand& Command, TArray<FEditorCommandRequest>&& Group,
+                                            TArray<FEditorCommandResult>&& Results, const double ExecuteStartTime)
+{
+	// 1. Stage timestamps (for resumable commands, execute spans every frame the task was stepped in)
+	const double ExecuteEndTime = FPlatformTime::Seconds();
+	for (FEditorCommandRequest& Request : Group)
+	{
+		Request.Timing.ExecuteStartTime = ExecuteStartTime;
+		Request.Timing.ExecuteEndTime = ExecuteEndTime;
+	}
+
+	// 2. The world snapshot follows most edits through the editor's change delegates; commands that
+	//    bypass them rebuild it. Snapshot reads resume once it has published the edits.
+	if (Command.ModifiesEditor())
+	{
+		ResultCache->Invalidate();
+		if (Command.HasUntrackedEdits())
+		{
+			WorldSnapshot->MarkAllDirty();
+		}
+		NumPendingWrites.fetch_sub(Group.Num(), std::memory_order_acq_rel);
+	}
+
+	// 3. Serialize and complete on a worker thread
+	AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask,
+	          [Requests = MoveTemp(Group), Results = MoveTemp(Results), ResultCache = ResultCache, Metrics = Metrics]()
+	          {
+		          for (int32 Index = 0; Index < Requests.Num(); ++Index)
+		          {
+			          CompleteRequest(Requests[Index], Results.IsValidIndex(Index) ? &Results[Index] : nullptr, *ResultCache, *Metrics);
+		          }
+	          });
+}
+
+void FEditorCommandScheduler::CompleteRequest(const FEditorCommandRequest& Request, const FEditorCommandResult* Result,
+                                              FEditorCommandResultCache& ResultCache, FMCPMetrics& Metrics)
+{
+	MCP_TRACE_REQUEST_SCOPE("Serialize", Request.CommandName, Request.RequestId);
+
+	FMCPCommandResponse Response;
+	if (Result)
+	{
+		Response.success = true;
+		Response.message = TEXT("Command executed successfully");
+		Response.data = Result->ToJsonObjectWrapper();
+	}
+	else
+	{
+		Response.success = false;
+		Response.error = TEXT("Command returned no result");
+	}
+
+	// Commands report their own failures through a "success" field in the result data, and
+	// aborts by a timeout through a "timed_out" field
+	bool bCommandSucceeded = true;
+	bool bCommandTimedOut = false;
+	if (Response.data.JsonObject.IsValid())
+	{
+		Response.data.JsonObject->TryGetBoolField(TEXT("success"), bCommandSucceeded);
+		Response.data.JsonObject->TryGetBoolField(TEXT("timed_out"), bCommandTimedOut);
+	}
+
+	// 1. Serialize (with a _timing block when requested; those bodies are never cached)
+	FMCPRequestTiming Timing = Request.Timing;
+	TUniquePtr<FHttpServerResponse> HttpResponse;
+	if (Request.bIncludeTiming)
+	{
+		const TSharedRef<FJsonObject> ResponseObject = MakeShared<FJsonObject>();
+		FJsonObjectConverter::UStructToJsonObject(FMCPCommandResponse::StaticStruct(), &Response, ResponseObject);
+		Timing.SerializeEndTime = FPlatformTime::Seconds();
+		ResponseObject->SetObjectField(TEXT("_timing"), Timing.ToJsonObject(Timing.SerializeEndTime));
+		HttpResponse = FMCPJsonHelpers::CreateJsonObjectResponse(ResponseObject);
+	}
+	else
+	{
+		HttpResponse = FMCPJsonHelpers::CreateJsonResponse(Response);
+		Timing.SerializeEndTime = FPlatformTime::Seconds();
+
+		// Failures (e.g. no editor world yet) are not cached; the next call may well succeed
+		if (Result && bCommandSucceeded && !Request.CacheKey.IsEmpty() && HttpResponse->Code == EHttpServerResponseCodes::Ok)
+		{
+			ResultCache.Store(Request.CacheKey, Request.CacheRevision, HttpResponse->Body);
+		}
+	}
+
+	// 2. Latency attribution for the client
+	HttpResponse->Headers.Add(TEXT("Server-Timing"), {Timing.ToServerTimingHeader(FPlatformTime::Seconds())});
+
+	// 3. Metrics
+	if (Request.Metrics)
+	{
+		if (bCommandTimedOut)
+		{
+			FMCPMetrics::RecordTimeout(*Request.Metrics);
+		}
+
+		Metrics.RecordRequestCompleted(*Request.Metrics, Request.RequestId, Timing, Request.RequestBytes, *HttpResponse,
+		                               !Response.success || !bCommandSucceeded ||
+		                               HttpResponse->Code != EHttpServerResponseCodes::Ok);
+	}
+
+	// 4. The HTTP server's connections are ticked on the game thread and are not thread-safe
+	AsyncTask(ENamedThreads::GameThread, [OnComplete = Request.OnComplete, HttpResponse = MoveTemp(HttpResponse)]() mutable
+	{
+		OnComplete(MoveTemp(HttpResponse));
+	});
+}
+
+void FEditorCommandScheduler::CancelPendingRequests()
+{
+	for (int32 LaneIndex = 0; LaneIndex < NumLanes; ++LaneIndex)
+	{
+		FEditorCommandRequest Request;
+		while (IncomingRequests[LaneIndex].Dequeue(Request))
+		{
+			CancelRequest(Request);
+		}
+
+		FLane& Lane = Lanes[LaneIndex];
+		if (Lane.ActiveTask)
+		{
+			for (FEditorCommandRequest& ActiveRequest : Lane.ActiveTask->Requests)
+			{
+				CancelRequest(ActiveRequest);
+			}
+		}
+		for (const TUniquePtr<FActiveTask>& ParkedTask : Lane.ParkedTasks)
+		{
+			for (FEditorCommandRequest& ParkedRequest : ParkedTask->Requests)
+			{
+				CancelRequest(ParkedRequest);
+			}
+		}
+		for (FSessionQueue& Session : Lane.Sessions)
+		{
+			for (FEditorCommandRequest& PendingRequest : Session.Requests)
+			{
+				CancelRequest(PendingRequest);
+			}
+		}
+		Lane = FLane();
+	}
+}
+
+void FEditorCommandScheduler::CancelRequest(FEditorCommandRequest& Request)
+{
+	TUniquePtr<FHttpServerResponse> HttpResponse = FMCPJsonHelpers::CreateErrorResponse(
+		TEXT("Server is shutting down"), EHttpServerResponseCodes::ServiceUnavail);
+	if (Request.Metrics)
+	{
+		Metrics->RecordRequestCompleted(*Request.Metrics, Request.RequestId, Request.Timing, Request.RequestBytes,
+		                                *HttpResponse, true);
+	}
+	Request.OnComplete(MoveTemp(HttpResponse));
+}
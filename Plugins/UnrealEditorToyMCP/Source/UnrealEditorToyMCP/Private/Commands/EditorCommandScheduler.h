@@ -0,0 +1,285 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Queue.h"
+#include "Containers/Ticker.h"
+#include "HttpResultCallback.h"
+#include "IEditorCommand.h"
+#include "MCPMetrics.h"
+#include <atomic>
+
+class FEditorCommandResultCache;
+class FMCPMetrics;
+class FMCPWorldSnapshot;
+class FMCPWorldSnapshotBuilder;
+
+/**
+ * A command invocation waiting to be executed on the game thread
+ */
+struct FEditorCommandRequest
+{
+	// Resolved command (owned by the registry, which outlives the scheduler; game thread only)
+	IEditorCommand* Command = nullptr;
+
+	// Server-wide unique id (tags trace scopes and logs)
+	uint64 RequestId = 0;
+
+	TSharedPtr<FJsonObject> Params;
+	FHttpResultCallback OnComplete;
+
+	// Params decoded into the command's params struct (only for commands that declare one)
+	FInstancedStruct TypedParams;
+
+	// Result cache key (empty if the command is not cacheable) and the revision it was looked up at
+	FString CacheKey;
+	uint64 CacheRevision = 0;
+
+	// Metric slot of the command (null when metrics are not recorded) and stage timestamps
+	FMCPCommandMetrics* Metrics = nullptr;
+	FMCPRequestTiming Timing;
+	int32 RequestBytes = 0;
+
+	// Add a _timing block to the response body (requested with the X-MCP-Timing header)
+	bool bIncludeTiming = false;
+
+	// Scheduling class (command default, optionally lowered by X-MCP-Priority)
+	EEditorCommandPriority Priority = EEditorCommandPriority::Interactive;
+
+	// Client session (X-MCP-Session header, empty for anonymous clients)
+	FString SessionId;
+
+	// Name of the command, for the worker thread stages that must not touch the command itself
+	FName CommandName;
+};
+
+/**
+ * Scheduler for editor commands
+ * Requests are queued from any thread into one queue per priority class and moved to the
+ * game thread once per frame:
+ *   - control requests are executed completely every frame
+ *   - interactive and bulk requests share a per-frame time budget (mcp.Scheduler.FrameBudgetMs)
+ *     by weighted round-robin (mcp.Scheduler.InteractiveWeight / BulkWeight)
+ *   - within a class, client sessions take turns, so one session's backlog cannot starve another
+ * Pending invocations of a batchable command at the head of each session in a class are merged
+ * into a single ExecuteBatch call, so N concurrent queries cost roughly one execution.
+ * Commands that return a task from Begin are stepped across frames within the same budget;
+ * a lane runs its current task to completion before starting the next request, unless the task
+ * yields its lane (long-running scripts). Such a task is parked after its first step and stepped
+ * in turn with the lane's new requests; only requests its own session queued behind it wait for it.
+ * Response serialization runs on a task graph worker, which also fills the result cache for
+ * cacheable commands; OnComplete is then called back on the game thread, where the HTTP server
+ * ticks its connections.
+ * Reads that can be answered from the world snapshot skip the lanes and run entirely on a worker.
+ * Every response carries a Server-Timing header with the stage durations of its request.
+ */
+class FEditorCommandScheduler
+{
+public:
+	FEditorCommandScheduler(const TSharedRef<FEditorCommandResultCache>& InResultCache, const TSharedRef<FMCPMetrics>& InMetrics,
+	                        const TSharedRef<FMCPWorldSnapshotBuilder>& InWorldSnapshot);
+	~FEditorCommandScheduler();
+
+	/**
+	 * Queue a command for execution on the game thread
+	 * Thread-safe; may be called from the HTTP thread
+	 * @param Request Command invocation to execute
+	 */
+	void Enqueue(FEditorCommandRequest&& Request);
+
+	/**
+	 * Answer a read-only request from a world snapshot on a worker thread, bypassing the lanes
+	 * The command must have accepted the snapshot with CanExecuteOnSnapshot.
+	 * Thread-safe
+	 * @param Request Command invocation to answer
+	 * @param Command The request's command (kept alive until it has executed, even if the server shuts down)
+	 * @param Snapshot Snapshot to read from (kept alive until the request is complete)
+	 */
+	void ExecuteOnSnapshot(FEditorCommandRequest&& Request, const TSharedRef<const IEditorCommand>& Command,
+	                       const TSharedRef<const FMCPWorldSnapshot>& Snapshot);
+
+	/**
+	 * Check whether a command that modifies the editor is queued or executing
+	 * Snapshot reads are only consistent when no edit is still in flight.
+	 * @return True if a write has not completed yet
+	 */
+	bool HasPendingWrites() const { return NumPendingWrites.load(std::memory_order_acquire) > 0; }
+
+	/**
+	 * Check whether requests are waiting for (or being stepped on) the game thread
+	 * Must be called on the game thread
+	 * @return True if any queue or lane has work
+	 */
+	bool HasPendingWork() const;
+
+	/**
+	 * Get the rate the scheduler is ticked at, i.e. how often queued requests can start
+	 * @return Smoothed ticks per second
+	 */
+	float GetTickRate() const { return AverageDeltaTime > 0.0f ? 1.0f / AverageDeltaTime : 0.0f; }
+
+private:
+	// Pending requests of one client session within a priority class, in arrival order
+	struct FSessionQueue
+	{
+		FString SessionId;
+		TArray<FEditorCommandRequest> Requests;
+	};
+
+	// Resumable command in progress, with the requests it answers
+	struct FActiveTask
+	{
+		IEditorCommand* Command = nullptr;
+		TArray<FEditorCommandRequest> Requests;
+		TArray<FEditorCommandInvocation> Invocations;
+		TUniquePtr<IEditorCommandTask> Task;
+		double ExecuteStartTime = 0.0;
+	};
+
+	// Game thread backlog of one priority class
+	struct FLane
+	{
+		TArray<FSessionQueue> Sessions;
+		int32 NextSession = 0;
+		int32 NumPending = 0;
+
+		// Resumable command being stepped (requests in it are not counted in NumPending)
+		TUniquePtr<FActiveTask> ActiveTask;
+
+		// Resumable commands that gave up the lane between steps, stepped in turn with new requests
+		TArray<TUniquePtr<FActiveTask>> ParkedTasks;
+		int32 NextParkedTask = 0;
+		bool bParkedTurn = false;
+
+		// Smooth weighted round-robin state
+		int32 Credit = 0;
+
+		bool HasWork() const { return NumPending > 0 || ActiveTask.IsValid() || !ParkedTasks.IsEmpty(); }
+	};
+
+	static constexpr int32 NumLanes = static_cast<int32>(EEditorCommandPriority::Num);
+
+	/** Game thread tick: executes pending requests within the frame budget */
+	bool Tick(float DeltaTime);
+
+	/** Move queued requests into the game thread lanes */
+	void DrainIncoming();
+
+	/**
+	 * Pick the next interactive or bulk lane to execute from
+	 * @return Lane index, or INDEX_NONE if both are empty
+	 */
+	int32 PickWeightedLane();
+
+	/**
+	 * Step the lane's resumable command, or start the next request (or batch) of the lane,
+	 * taking turns between its sessions and its parked tasks
+	 * @param Lane Lane with work
+	 * @param BudgetSeconds Game thread time left for a resumable step
+	 */
+	void ExecuteNext(FLane& Lane, double BudgetSeconds);
+
+	/**
+	 * Find the next session of a lane that may start a request
+	 * Sessions with a parked task wait for it, so they never see a script's partial edits.
+	 * @param Lane Lane to search
+	 * @return Session index, or INDEX_NONE if every session waits for a parked task
+	 */
+	static int32 FindNextSession(const FLane& Lane);
+
+	/**
+	 * Check whether a session waits for one of the lane's parked tasks
+	 * Anonymous clients share a session and never wait; they are not ordered against each other.
+	 * @param Lane Lane with the parked tasks
+	 * @param SessionId Session to check
+	 * @return True if a parked task answers a request of the session
+	 */
+	static bool IsSessionParked(const FLane& Lane, const FString& SessionId);
+
+	/**
+	 * Start a group of pending requests for the same command
+	 * Resumable commands become the lane's active task; others execute in a single call.
+	 * @param Lane Lane the group was taken from
+	 * @param Command Command shared by every request in the group
+	 * @param Group Requests to execute
+	 * @param BudgetSeconds Game thread time left for the first step
+	 */
+	void StartGroup(FLane& Lane, IEditorCommand& Command, TArray<FEditorCommandRequest>&& Group, double BudgetSeconds);
+
+	/**
+	 * Step the lane's active task, parking it if it yields its lane
+	 * @param Lane Lane with an active task
+	 * @param BudgetSeconds Game thread time the step should stay within
+	 */
+	void StepActiveTask(FLane& Lane, double BudgetSeconds);
+
+	/**
+	 * Step the lane's parked tasks in turn, one per call
+	 * @param Lane Lane with parked tasks
+	 * @param BudgetSeconds Game thread time the step should stay within
+	 */
+	void StepParkedTask(FLane& Lane, double BudgetSeconds);
+
+	/**
+	 * Step a resumable command and complete its requests once it is done
+	 * @param ActiveTask Task to step
+	 * @param BudgetSeconds Game thread time the step should stay within
+	 * @return True if the task is done and its requests were completed
+	 */
+	bool StepTask(FActiveTask& ActiveTask, double BudgetSeconds);
+
+	/**
+	 * Hand executed requests to a worker for serialization and completion
+	 * @param Command Command shared by every request in the group
+	 * @param Group Executed requests
+	 * @param Results One result per request
+	 * @param ExecuteStartTime Time the execution started
+	 */
+	void CompleteGroup(IEditorCommand& Command, TArray<FEditorCommandRequest>&& Group,
+	                   TArray<FEditorCommandResult>&& Results, double ExecuteStartTime);
+
+	/**
+	 * Serialize a command result and complete its request
+	 * Runs on a worker thread; OnComplete is dispatched to the game thread
+	 * @param Request Request to complete
+	 * @param Result Command result, or nullptr if the command produced none
+	 * @param ResultCache Cache to store the serialized response in (cacheable commands only)
+	 * @param Metrics Metrics to record the request in
+	 */
+	static void CompleteRequest(const FEditorCommandRequest& Request, const FEditorCommandResult* Result,
+	                            FEditorCommandResultCache& ResultCache, FMCPMetrics& Metrics);
+
+	/** Fail every pending request (used on shutdown) */
+	void CancelPendingRequests();
+
+	/**
+	 * Fail a request that will not be executed
+	 * @param Request Request to fail
+	 */
+	void CancelRequest(FEditorCommandRequest& Request);
+
+	// Requests queued by the HTTP thread, one queue per priority class, consumed by the game thread
+	TQueue<FEditorCommandRequest, EQueueMode::Mpsc> IncomingRequests[NumLanes];
+
+	// Requests moved to the game thread but not executed yet (game thread only)
+	FLane Lanes[NumLanes];
+
+	// Result cache (invalidated by commands that modify the editor)
+	TSharedRef<FEditorCommandResultCache> ResultCache;
+
+	// World snapshot (rebuilt after commands whose edits no change delegate reports)
+	TSharedRef<FMCPWorldSnapshotBuilder> WorldSnapshot;
+
+	// Requests that modify the editor, queued or executing
+	std::atomic<int32> NumPendingWrites{0};
+
+	// Request metrics (game thread time per frame, completed requests)
+	TSharedRef<FMCPMetrics> Metrics;
+
+	// Smoothed time between ticks (game thread only)
+	float AverageDeltaTime = 0.0f;
+
+	// Core ticker registration
+	FTSTicker::FDelegateHandle TickerHandle;
+};
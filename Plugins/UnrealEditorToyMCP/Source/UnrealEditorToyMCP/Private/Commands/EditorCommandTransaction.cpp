@@ -0,0 +1,82 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "EditorCommandTransaction.h"
+#include "Editor.h"
+#include "Engine/World.h"
+#include "Misc/Paths.h"
+
+FEditorCommandTransaction::FEditorCommandTransaction(const FText& InDescription)
+	: Description(InDescription)
+{
+}
+
+FEditorCommandTransaction::~FEditorCommandTransaction()
+{
+	End();
+}
+
+bool FEditorCommandTransaction::Begin()
+{
+	if (bOpen || IsInterrupted() || !GEditor)
+	{
+		return false;
+	}
+
+	GEditor->BeginTransaction(Description);
+	bOpen = true;
+
+	// Only listened to while open, so idle commands cost nothing
+	FEditorDelegates::OnMapLoad.AddRaw(this, &FEditorCommandTransaction::HandleMapLoad);
+	FEditorDelegates::PreBeginPIE.AddRaw(this, &FEditorCommandTransaction::HandlePreBeginPIE);
+	FWorldDelegates::OnWorldCleanup.AddRaw(this, &FEditorCommandTransaction::HandleWorldCleanup);
+	return true;
+}
+
+void FEditorCommandTransaction::End()
+{
+	if (!bOpen)
+	{
+		return;
+	}
+	bOpen = false;
+
+	FEditorDelegates::OnMapLoad.RemoveAll(this);
+	FEditorDelegates::PreBeginPIE.RemoveAll(this);
+	FWorldDelegates::OnWorldCleanup.RemoveAll(this);
+
+	if (GEditor)
+	{
+		GEditor->EndTransaction();
+	}
+}
+
+void FEditorCommandTransaction::Interrupt(const FString& Reason)
+{
+	if (!bOpen)
+	{
+		return;
+	}
+
+	// Close it before the editor resets the undo history (which asserts no transaction is active);
+	// what was recorded so far stays one undo step, unless the reset discards it
+	InterruptReason = Reason;
+	End();
+}
+
+void FEditorCommandTransaction::HandleMapLoad(const FString& Filename, FCanLoadMap& OutCanLoadMap)
+{
+	Interrupt(FString::Printf(TEXT("Aborted: the map %s was loaded while the edit was in progress"), *FPaths::GetBaseFilename(Filename)));
+}
+
+void FEditorCommandTransaction::HandleWorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources)
+{
+	if (World && World->WorldType == EWorldType::Editor)
+	{
+		Interrupt(TEXT("Aborted: the editor world was unloaded while the edit was in progress"));
+	}
+}
+
+void FEditorCommandTransaction::HandlePreBeginPIE(bool bIsSimulating)
+{
+	Interrupt(TEXT("Aborted: a Play In Editor session started while the edit was in progress"));
+}
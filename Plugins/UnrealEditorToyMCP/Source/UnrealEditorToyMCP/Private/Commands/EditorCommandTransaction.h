@@ -0,0 +1,57 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UWorld;
+struct FCanLoadMap;
+
+/**
+ * Editor undo transaction that stays open across the steps of a resumable command
+ * FScopedTransaction cannot outlive a single step; this one begins on first use and ends when the
+ * command finishes or its task is destroyed, so an edit spread over many frames is still one undo step.
+ * Edits the user makes while it is open are recorded into it as well.
+ * The editor resets its undo history when a map is loaded or created, which must not happen with a
+ * transaction open; the transaction is therefore ended early, and marked interrupted, when a map is
+ * loaded, the editor world is cleaned up or a PIE session starts. The command should then abort.
+ * Game thread only.
+ */
+class FEditorCommandTransaction
+{
+public:
+	explicit FEditorCommandTransaction(const FText& InDescription);
+	~FEditorCommandTransaction();
+
+	FEditorCommandTransaction(const FEditorCommandTransaction&) = delete;
+	FEditorCommandTransaction& operator=(const FEditorCommandTransaction&) = delete;
+
+	/**
+	 * Begin the transaction unless it is already open or was interrupted
+	 * @return True if this call opened it (the caller should Modify the objects it records once)
+	 */
+	bool Begin();
+
+	/** End the transaction if it is open */
+	void End();
+
+	/** True while the transaction is open */
+	bool IsOpen() const { return bOpen; }
+
+	/** True once the transaction was ended early by a map load, world cleanup or PIE start */
+	bool IsInterrupted() const { return !InterruptReason.IsEmpty(); }
+
+	/** Why the transaction was interrupted (empty if it was not) */
+	const FString& GetInterruptReason() const { return InterruptReason; }
+
+private:
+	void Interrupt(const FString& Reason);
+
+	void HandleMapLoad(const FString& Filename, FCanLoadMap& OutCanLoadMap);
+	void HandleWorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources);
+	void HandlePreBeginPIE(bool bIsSimulating);
+
+	FText Description;
+	bool bOpen = false;
+	FString InterruptReason;
+};
@@ -1,183 +1,364 @@
 // Fill out your copyright notice in the Description page of Project Settings.
 
 #include "ExecutePythonCommand.h"
-#include "PythonOutputDevice.h"
-#include "Editor.h"
-#include "Engine/World.h"
-#include "Misc/FileHelper.h"
+#include "Async/Async.h"
 #include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "IPythonScriptPlugin.h"
+#include "Misc/FileHelper.h"
+#include "Hash/xxhash.h"
 #include "Misc/Paths.h"
-#include "JsonObjectConverter.h"
 #include "MCPJsonStructs.h"
+#include "Python/MCPPythonJobs.h"
+#include "Python/MCPPythonLibrary.h"
+#include "Serialization/JsonSerializer.h"
+#include "UnrealEditorMCP.h"
 
-FString FExecutePythonCommand::GetName() const
-{
-	return TEXT("execute_python");
-}
+static TAutoConsoleVariable<bool> CVarMCPPythonSaveScripts(
+	TEXT("mcp.Python.SaveScripts"),
+	false,
+	TEXT("Also write every script run by execute_python to Saved/MCP/PythonScripts (debugging aid; written asynchronously)."),
+	ECVF_Default);
 
-FString FExecutePythonCommand::GetDescription() const
-{
-	return TEXT("Execute a Python script in the Unreal Editor");
-}
+static TAutoConsoleVariable<int32> CVarMCPPythonCodeCacheSize(
+	TEXT("mcp.Python.CodeCacheSize"),
+	128,
+	TEXT("Number of compiled execute_python scripts kept by mcp_runtime (least recently used are evicted). 0 disables the cache."),
+	ECVF_Default);
 
-TArray<FCommandParameter> FExecutePythonCommand::GetParameters() const
-{
-	TArray<FCommandParameter> Parameters;
-	Parameters.Add(FCommandParameter(
-		TEXT("script_content"),
-		TEXT("string"),
-		true,
-		TEXT("Python script content to execute")
-	));
-	Parameters.Add(FCommandParameter(
-		TEXT("script_name"),
-		TEXT("string"),
-		false,
-		TEXT("Optional script name (auto-generated if not provided)")
-	));
-	return Parameters;
-}
+static TAutoConsoleVariable<float> CVarMCPPythonTimeoutSeconds(
+	TEXT("mcp.Python.TimeoutSeconds"),
+	120.0f,
+	TEXT("Default seconds an execute_python script may hold the game thread (a whole plain script, or the time between two yields) before the watchdog interrupts it. 0 disables the watchdog."),
+	ECVF_Default);
 
-FJsonObjectWrapper FExecutePythonCommand::Execute(const TSharedPtr<FJsonObject>& Params)
+namespace
 {
-	FExecutePythonCommandResponse Response;
+	// Statements evaluated for every script; the script itself is fetched through UMCPPythonLibrary
+	const TCHAR* RunScriptStatement = TEXT("__import__('mcp_runtime').run()");
+	const TCHAR* ResumeScriptStatement = TEXT("__import__('mcp_runtime').resume()");
+	const TCHAR* DiscardScriptStatement = TEXT("__import__('mcp_runtime').discard()");
 
-	// 1. Validate parameters
-	if (!Params.IsValid())
+	FString HashScriptSource(const FString& Source)
 	{
-		Response.success = false;
-		Response.error = TEXT("Missing parameters");
-
-		FJsonObjectWrapper Wrapper;
-		Wrapper.JsonObject = FJsonObjectConverter::UStructToJsonObject(Response);
-		return Wrapper;
+		const FXxHash128 Hash = FXxHash128::HashBuffer(*Source, Source.Len() * sizeof(TCHAR));
+		return FString::Printf(TEXT("%016llx%016llx"), Hash.Hi, Hash.Lo);
 	}
 
-	// 2. Get script_content (required)
-	FString ScriptContent;
-	if (!Params->TryGetStringField(TEXT("script_content"), ScriptContent) || ScriptContent.IsEmpty())
+	FString SerializeArgs(const FJsonObjectWrapper& Args)
 	{
-		Response.success = false;
-		Response.error = TEXT("Missing or empty 'script_content' parameter");
-
-		FJsonObjectWrapper Wrapper;
-		Wrapper.JsonObject = FJsonObjectConverter::UStructToJsonObject(Response);
-		return Wrapper;
+		FString ArgsJson;
+		if (Args.JsonObject.IsValid() && Args.JsonObject->Values.Num() > 0)
+		{
+			const TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer =
+				TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&ArgsJson);
+			FJsonSerializer::Serialize(Args.JsonObject.ToSharedRef(), Writer);
+		}
+		return ArgsJson;
 	}
 
-	// 3. Get script_name (optional, auto-generate if not provided)
-	FString ScriptName;
-	if (!Params->TryGetStringField(TEXT("script_name"), ScriptName) || ScriptName.IsEmpty())
+	int64 GetUtf8Size(const FString& Text)
 	{
-		FDateTime Now = FDateTime::Now();
-		ScriptName = FString::Printf(TEXT("script_%s"), *Now.ToString(TEXT("%Y%m%d_%H%M%S")));
+		return FPlatformString::ConvertedLength<UTF8CHAR>(*Text, Text.Len());
 	}
 
-	// 4. Ensure directory exists
-	const FString ScriptDir = EnsurePythonScriptDirectory();
-	if (ScriptDir.IsEmpty())
+	/**
+	 * Write a copy of the script for debugging without blocking the game thread
+	 * @param ScriptName Script name (without or with .py extension)
+	 * @param ScriptContent Python script content
+	 * @return Path the script will be written to
+	 */
+	FString SaveScriptAsync(const FString& ScriptName, const FString& ScriptContent)
 	{
-		Response.success = false;
-		Response.error = TEXT("Failed to create Python script directory");
+		const FString ScriptDir = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("MCP"), TEXT("PythonScripts"));
+		const FString FileName = ScriptName.EndsWith(TEXT(".py")) ? ScriptName : ScriptName + TEXT(".py");
+		FString ScriptPath = FPaths::Combine(ScriptDir, FileName);
+
+		AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [ScriptDir, ScriptPath, ScriptContent]()
+		{
+			if (!IFileManager::Get().MakeDirectory(*ScriptDir, true) || !FFileHelper::SaveStringToFile(ScriptContent, *ScriptPath))
+			{
+				UE_LOG(LogUnrealEditorMCP, Warning, TEXT("UnrealEditorMCP: Failed to save Python script: %s"), *ScriptPath);
+			}
+		});
 
-		FJsonObjectWrapper Wrapper;
-		Wrapper.JsonObject = FJsonObjectConverter::UStructToJsonObject(Response);
-		return Wrapper;
+		return ScriptPath;
 	}
 
-	// 5. Write a script to file
-	const FString ScriptPath = GeneratePythonScriptPath(ScriptName);
-	if (!FFileHelper::SaveStringToFile(ScriptContent, *ScriptPath))
+	/**
+	 * Execution of one script
+	 * Plain scripts complete in the first step; generator scripts are resumed by every later step
+	 * until mcp_runtime reports them done.
+	 */
+	class FExecutePythonTask : public IEditorCommandTask
 	{
-		Response.success = false;
-		Response.error = TEXT("Failed to write script file");
+	public:
+		FExecutePythonTask(const FExecutePythonCommandParams& InParams, const TSharedRef<FMCPPythonJobRegistry>& InJobs,
+		                   int64& InCodeCacheHits, int64& InCodeCacheMisses)
+			: Params(InParams)
+			  , Jobs(InJobs)
+			  , CodeCacheHits(InCodeCacheHits)
+			  , CodeCacheMisses(InCodeCacheMisses)
+		{
+			// 1. script_content (required) was validated by the dispatch layer before queueing
+			const FString& ScriptContent = Params.script_content;
 
-		FJsonObjectWrapper Wrapper;
-		Wrapper.JsonObject = FJsonObjectConverter::UStructToJsonObject(Response);
-		return Wrapper;
-	}
+			// 2. Get script_name (optional, auto-generate if not provided)
+			FString ScriptName = Params.script_name;
+			if (ScriptName.IsEmpty())
+			{
+				FDateTime Now = FDateTime::Now();
+				ScriptName = FString::Printf(TEXT("script_%s"), *Now.ToString(TEXT("%Y%m%d_%H%M%S")));
+			}
 
-	// 6. Check GEditor availability
-	if (!GEditor)
-	{
-		Response.success = false;
-		Response.error = TEXT("Editor not available");
+			// 3. Check Python availability
+			PythonScriptPlugin = IPythonScriptPlugin::Get();
+			if (!PythonScriptPlugin || !PythonScriptPlugin->IsPythonAvailable())
+			{
+				Fail(TEXT("Python is not available (is the Python Editor Script Plugin enabled?)"));
+				return;
+			}
 
-		FJsonObjectWrapper Wrapper;
-		Wrapper.JsonObject = FJsonObjectConverter::UStructToJsonObject(Response);
-		return Wrapper;
-	}
+			// 4. Register the job, so python_job can follow and cancel it
+			FString Error;
+			Job = Jobs->Add(Params.job_id, ScriptName, Error);
+			if (!Job)
+			{
+				Fail(Error);
+				return;
+			}
+			Response.job_id = Job->Id;
 
-	UWorld* World = GEditor->GetEditorWorldContext().World();
-	if (!World)
-	{
-		Response.success = false;
-		Response.error = TEXT("No active world");
+			// 5. Keep a copy of the script on disk only when debugging asks for it
+			if (CVarMCPPythonSaveScripts.GetValueOnGameThread())
+			{
+				Response.script_path = SaveScriptAsync(ScriptName, ScriptContent);
+			}
 
-		FJsonObjectWrapper Wrapper;
-		Wrapper.JsonObject = FJsonObjectConverter::UStructToJsonObject(Response);
-		return Wrapper;
-	}
+			Invocation.ScriptName = ScriptName;
+			Invocation.Source = ScriptContent;
+			Invocation.SourceHash = HashScriptSource(ScriptContent);
+			Invocation.ArgsJson = SerializeArgs(Params.args);
+			Invocation.CodeCacheCapacity = CVarMCPPythonCodeCacheSize.GetValueOnGameThread();
+			Invocation.SessionId = Params.session_id;
+			Invocation.bIncludeOutput = Params.include_output;
+			Invocation.JobId = Job->Id;
+			Invocation.TimeoutSeconds = Params.timeout_seconds > 0.0
+				                            ? Params.timeout_seconds
+				                            : CVarMCPPythonTimeoutSeconds.GetValueOnGameThread();
 
-	// 7. Execute Python script via console command
-	FPythonOutputDevice OutputDevice;
-	FString PyScriptContent = FString::Printf(TEXT("py %s"), *ScriptContent);
-	GEditor->Exec(World, *PyScriptContent, OutputDevice);
+			MaxOutputBytes = UMCPPythonLibrary::GetOutputCapacity();
+		}
 
-	// 8. Get output and detect errors
-	const FString Output = OutputDevice.GetTrimmedOutput();
-	const bool bHasError = DetectPythonError(Output);
+		virtual ~FExecutePythonTask() override
+		{
+			if (!Job)
+			{
+				return;
+			}
 
-	// 9. Build response
-	Response.success = !bHasError;
-	Response.output = Output;
-	Response.script_path = ScriptPath;
+			// Abandoned mid-run (server shutdown): let the generator clean up, then forget the job
+			IPythonScriptPlugin* Plugin = IPythonScriptPlugin::Get();
+			if (bStarted && Plugin && Plugin->IsPythonAvailable())
+			{
+				FString Error;
+				RunStatement(DiscardScriptStatement, Error);
+			}
+			Jobs->Remove(Job->Id);
+		}
 
-	if (bHasError)
-	{
-		Response.error = TEXT("Python script execution failed (see output)");
-	}
+		virtual EEditorCommandStepResult Step(const double BudgetSeconds) override
+		{
+			if (!Job)
+			{
+				return EEditorCommandStepResult::Done;
+			}
 
-	FJsonObjectWrapper Wrapper;
-	Wrapper.JsonObject = FJsonObjectConverter::UStructToJsonObject(Response);
-	return Wrapper;
-}
+			// 1. Run the script, or resume it where it last yielded
+			Invocation.StepBudgetSeconds = BudgetSeconds;
+			Invocation.bCancelRequested = Job->bCancelRequested;
+			Invocation.bJobDone = true;
 
-FString FExecutePythonCommand::EnsurePythonScriptDirectory() const
-{
-	FString ProjectContentDir = FPaths::ProjectContentDir();
-	FString ScriptDir = FPaths::Combine(ProjectContentDir, TEXT("Python"), TEXT("Scripts"));
+			if (!bStarted)
+			{
+				UE_LOG(LogUnrealEditorMCP, Verbose, TEXT("UnrealEditorMCP: Executing Python script %s (%d chars)"),
+				       *Invocation.ScriptName, Invocation.Source.Len());
+			}
 
-	if (!IFileManager::Get().DirectoryExists(*ScriptDir))
-	{
-		if (!IFileManager::Get().MakeDirectory(*ScriptDir, true))
+			FString Error;
+			const bool bSucceeded = RunStatement(bStarted ? ResumeScriptStatement : RunScriptStatement, Error);
+
+			if (!bStarted)
+			{
+				bStarted = true;
+				++(Invocation.bCodeCacheHit ? CodeCacheHits : CodeCacheMisses);
+				Response.code_cache.hit = Invocation.bCodeCacheHit;
+				Response.code_cache.entries = Invocation.CodeCacheEntries;
+				Response.code_cache.hits = CodeCacheHits;
+				Response.code_cache.misses = CodeCacheMisses;
+			}
+
+			// 2. Publish progress for python_job
+			++Job->Steps;
+			Job->Progress = Invocation.JobProgress;
+			Job->Message = Invocation.JobMessage;
+
+			if (bSucceeded && !Invocation.bJobDone)
+			{
+				return EEditorCommandStepResult::Continue;
+			}
+
+			// 3. Done, failed, timed out or cancelled (on failure, Error holds the exception and traceback)
+			if (Invocation.bTimedOut)
+			{
+				UE_LOG(LogUnrealEditorMCP, Warning, TEXT("UnrealEditorMCP: Python script %s timed out after %.1f seconds"),
+				       *Invocation.ScriptName, Invocation.TimeoutSeconds);
+				Response.timed_out = true;
+				Error = FString::Printf(TEXT("Script timed out after %.1f seconds without yielding%s%s"),
+				                        Invocation.TimeoutSeconds, Error.IsEmpty() ? TEXT("") : TEXT("\n"), *Error);
+			}
+			else if (!bSucceeded)
+			{
+				Error = Error.IsEmpty() ? TEXT("Python script execution failed (see output)") : Error;
+			}
+			else if (Invocation.bJobCancelled)
+			{
+				Response.cancelled = true;
+				Error = FString::Printf(TEXT("Job '%s' was cancelled"), *Job->Id);
+			}
+
+			Response.success = Error.IsEmpty();
+			Response.error = MoveTemp(Error);
+			Response.steps = Job->Steps;
+			BuildOutput();
+			Response.result = MoveTemp(Invocation.ResultJson);
+
+			Jobs->Remove(Job->Id);
+			Job.Reset();
+			return EEditorCommandStepResult::Done;
+		}
+
+		virtual TArray<FEditorCommandResult> Finish() override
 		{
-			UE_LOG(LogTemp, Error, TEXT("UnrealEditorMCP: Failed to create directory: %s"), *ScriptDir);
-			return FString();
+			return {FEditorCommandResult::Make(MoveTemp(Response))};
 		}
-		UE_LOG(LogTemp, Log, TEXT("UnrealEditorMCP: Created Python script directory: %s"), *ScriptDir);
-	}
 
-	return ScriptDir;
+		// A generator script can run for minutes; other bulk requests must not wait for it
+		virtual bool YieldsLane() const override { return true; }
+
+	private:
+		// Complete the task with an error before the script ran
+		void Fail(const FString& Error)
+		{
+			Response.success = false;
+			Response.error = Error;
+		}
+
+		// Evaluate a mcp_runtime statement with the invocation visible to UMCPPythonLibrary
+		bool RunStatement(const TCHAR* Statement, FString& OutError)
+		{
+			FPythonCommandEx PythonCommand;
+			PythonCommand.Command = Statement;
+			PythonCommand.ExecutionMode = EPythonCommandExecutionMode::EvaluateStatement;
+			PythonCommand.Flags |= EPythonCommandFlags::Unattended;
+
+			bool bSucceeded;
+			{
+				FMCPPythonInvocationScope InvocationScope(Invocation);
+				bSucceeded = PythonScriptPlugin->ExecPythonCommandEx(PythonCommand);
+			}
+
+			// Lines logged through unreal.log* in this step; always counted in output_bytes, and kept
+			// (when output is included) in order until the first one that does not fit under the cap
+			for (FPythonLogOutputEntry& Entry : PythonCommand.LogOutput)
+			{
+				const int64 EntryBytes = GetUtf8Size(Entry.Output) + 1;
+				const bool bNoneDropped = LoggedKeptBytes == LoggedBytes;
+				LoggedBytes += EntryBytes;
+				if (Params.include_output && bNoneDropped && LoggedKeptBytes + EntryBytes <= MaxOutputBytes)
+				{
+					LoggedKeptBytes += EntryBytes;
+					LoggedLines.Add(MoveTemp(Entry.Output));
+				}
+			}
+
+			if (!bSucceeded)
+			{
+				OutError = MoveTemp(PythonCommand.CommandResult);
+			}
+			return bSucceeded;
+		}
+
+		// Combine what the script printed (already bounded by mcp_runtime) with the lines it logged,
+		// dropping logged lines once the cap is reached
+		void BuildOutput()
+		{
+			int64 KeptBytes = Invocation.OutputBytes - Invocation.OutputTruncatedBytes;
+			Response.output_bytes = Invocation.OutputBytes + LoggedBytes;
+			Response.output_truncated_bytes = Invocation.OutputTruncatedBytes + LoggedBytes;
+
+			TStringBuilder<1024> Output;
+			Output.Append(Invocation.Output);
+			for (const FString& Line : LoggedLines)
+			{
+				const int64 LineBytes = GetUtf8Size(Line) + 1;
+				if (KeptBytes + LineBytes > MaxOutputBytes)
+				{
+					break;
+				}
+
+				KeptBytes += LineBytes;
+				Response.output_truncated_bytes -= LineBytes;
+				if (Output.Len() > 0 && Output.LastChar() != TEXT('\n'))
+				{
+					Output.AppendChar(TEXT('\n'));
+				}
+				Output.Append(Line);
+				Output.AppendChar(TEXT('\n'));
+			}
+
+			Response.output = FString(Output.ToView()).TrimStartAndEnd();
+		}
+
+		// Params are owned by the scheduler request and outlive the task
+		const FExecutePythonCommandParams& Params;
+
+		TSharedRef<FMCPPythonJobRegistry> Jobs;
+		TSharedPtr<FMCPPythonJob> Job;
+
+		int64& CodeCacheHits;
+		int64& CodeCacheMisses;
+
+		IPythonScriptPlugin* PythonScriptPlugin = nullptr;
+		FMCPPythonInvocation Invocation;
+		bool bStarted = false;
+
+		// Lines logged across all steps, bounded by MaxOutputBytes
+		TArray<FString> LoggedLines;
+		int64 LoggedBytes = 0;
+		int64 LoggedKeptBytes = 0;
+		int64 MaxOutputBytes = 0;
+
+		FExecutePythonCommandResponse Response;
+	};
 }
 
-FString FExecutePythonCommand::GeneratePythonScriptPath(const FString& ScriptName) const
+FExecutePythonCommand::FExecutePythonCommand(const TSharedRef<FMCPPythonJobRegistry>& InJobs)
+	: Jobs(InJobs)
+{
+}
+
+FString FExecutePythonCommand::GetName() const
+{
+	return TEXT("execute_python");
+}
+
+FString FExecutePythonCommand::GetDescription() const
 {
-	FString ScriptDir = EnsurePythonScriptDirectory();
-	FString FileName = ScriptName.EndsWith(TEXT(".py")) ? ScriptName : ScriptName + TEXT(".py");
-	return FPaths::Combine(ScriptDir, FileName);
+	return TEXT("Execute a Python script in the Unreal Editor (scripts that yield run across frames)");
 }
 
-bool FExecutePythonCommand::DetectPythonError(const FString& Output) const
+TUniquePtr<IEditorCommandTask> FExecutePythonCommand::BeginWithParams(const FExecutePythonCommandParams& Params)
 {
-	return Output.Contains(TEXT("Traceback")) ||
-		   Output.Contains(TEXT("SyntaxError")) ||
-		   Output.Contains(TEXT("NameError")) ||
-		   Output.Contains(TEXT("TypeError")) ||
-		   Output.Contains(TEXT("ValueError")) ||
-		   Output.Contains(TEXT("ImportError")) ||
-		   Output.Contains(TEXT("AttributeError")) ||
-		   Output.Contains(TEXT("KeyError")) ||
-		   Output.Contains(TEXT("IndexError")) ||
-		   Output.Contains(TEXT("RuntimeError"));
+	return MakeUnique<FExecutePythonTask>(Params, Jobs, CodeCacheHits, CodeCacheMisses);
 }
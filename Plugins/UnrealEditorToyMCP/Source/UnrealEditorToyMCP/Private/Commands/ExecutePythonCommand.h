@@ -3,43 +3,57 @@
 #pragma once
 
 #include "CoreMinimal.h"
-#include "IEditorCommand.h"
+#include "EditorCommandParams.h"
+
+class FMCPPythonJobRegistry;
 
 /**
  * ExecutePython command - Executes Python scripts in the Unreal Editor
+ * Scripts run from memory through the plugin's mcp_runtime Python module, which keeps compiled
+ * code in an LRU cache keyed by a hash of the source (mcp.Python.CodeCacheSize), so resending a
+ * script only costs the hash and its args. With mcp.Python.SaveScripts enabled, each script is
+ * also written to Saved/MCP/PythonScripts on a worker thread for debugging.
+ * Scripts given a session_id run in that session's namespace, which mcp_runtime keeps alive across
+ * calls until it is reset or closed (python_session) or stays idle past mcp.Python.SessionIdleTimeoutSeconds.
+ * Printed output is captured into a bounded buffer keeping its head and tail (mcp.Python.MaxOutputBytes),
+ * optionally echoed to the log line by line while the script runs (mcp.Python.EchoOutput).
+ * A script returns structured data with mcp.result(value) or a trailing expression; the value is
+ * serialized to JSON once in Python and embedded as-is in the response's result field.
+ * Every script is registered as a job. Scripts that yield are resumed on later frames within the
+ * scheduler's budget until they finish, giving up the bulk lane between steps so other bulk
+ * requests (including other scripts) run alongside them; python_job reports their progress and cancels them.
+ * A watchdog in mcp_runtime interrupts scripts that run longer than timeout_seconds (mcp.Python.TimeoutSeconds
+ * by default) without yielding; they fail with timed_out set and keep the output printed so far.
  * Parameters:
  *   - script_content (required): Python script content to execute
- *   - script_name (optional): Script name for logging (auto-generated if not provided)
+ *   - script_name (optional): Script name for logging and saved files (auto-generated if not provided)
+ *   - args (optional): JSON object bound into the script's namespace
+ *   - session_id (optional): Session whose namespace the script runs in (fresh namespace if not provided)
+ *   - include_output (optional): Whether to return printed and logged output (default true)
+ *   - job_id (optional): Id to follow and cancel the script with (generated if not provided)
+ *   - timeout_seconds (optional): Seconds the script may run without yielding (0 = mcp.Python.TimeoutSeconds)
  */
-class FExecutePythonCommand : public IEditorCommand
+class FExecutePythonCommand : public TTypedEditorCommand<FExecutePythonCommandParams>
 {
 public:
+	explicit FExecutePythonCommand(const TSharedRef<FMCPPythonJobRegistry>& InJobs);
 	virtual ~FExecutePythonCommand() override = default;
 
 	// IEditorCommand interface
 	virtual FString GetName() const override;
 	virtual FString GetDescription() const override;
-	virtual TArray<FCommandParameter> GetParameters() const override;
-	virtual FJsonObjectWrapper Execute(const TSharedPtr<FJsonObject>& Params) override;
+	virtual EEditorCommandPriority GetPriority() const override { return EEditorCommandPriority::Bulk; }
+	virtual bool HasUntrackedEdits() const override { return true; }
+
+protected:
+	// TTypedEditorCommand interface
+	virtual TUniquePtr<IEditorCommandTask> BeginWithParams(const FExecutePythonCommandParams& Params) override;
 
 private:
-	/**
-	 * Ensure Python script directory exists
-	 * @return Directory path, or empty string on failure
-	 */
-	FString EnsurePythonScriptDirectory() const;
-
-	/**
-	 * Generate full path for Python script file
-	 * @param ScriptName Script name (without or with .py extension)
-	 * @return Full file path
-	 */
-	FString GeneratePythonScriptPath(const FString& ScriptName) const;
-
-	/**
-	 * Detect if Python output contains errors
-	 * @param Output Output string from Python execution
-	 * @return True if error detected, false otherwise
-	 */
-	bool DetectPythonError(const FString& Output) const;
+	// Jobs in progress (shared with python_job)
+	TSharedRef<FMCPPythonJobRegistry> Jobs;
+
+	// Code cache totals since startup (game thread only)
+	int64 CodeCacheHits = 0;
+	int64 CodeCacheMisses = 0;
 };
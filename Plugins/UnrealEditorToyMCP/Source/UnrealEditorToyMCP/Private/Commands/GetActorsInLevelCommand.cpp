@@ -1,12 +1,13 @@
 // Fill out your copyright notice in the Description page of Project Settings.
 
 #include "GetActorsInLevelCommand.h"
+#include "ActorQueryFilter.h"
 #include "Engine/World.h"
 #include "GameFramework/Actor.h"
-#include "Kismet/GameplayStatics.h"
+#include "EngineUtils.h"
 #include "Editor.h"
-#include "JsonObjectConverter.h"
 #include "MCPJsonStructs.h"
+#include "MCPWorldSnapshot.h"
 
 FString FGetActorsInLevelCommand::GetName() const
 {
@@ -15,75 +16,196 @@ FString FGetActorsInLevelCommand::GetName() const
 
 FString FGetActorsInLevelCommand::GetDescription() const
 {
-	return TEXT("Get all actors in the current editor level");
+	return TEXT("Get actors in the current editor level, optionally filtered by class, tag or box");
 }
 
-TArray<FCommandParameter> FGetActorsInLevelCommand::GetParameters() const
+bool FGetActorsInLevelCommand::DecodeParams(const TSharedPtr<FJsonObject>& Params, FInstancedStruct& OutParams,
+                                            FString& OutError) const
 {
-	// This command has no parameters
-	return TArray<FCommandParameter>();
+	// All parameters are optional actor filters
+	OutParams.InitializeAs<FGetActorsInLevelCommandParams>();
+	return FActorQueryFilter::Decode(Params, OutParams.GetMutable<FGetActorsInLevelCommandParams>(), OutError);
 }
 
-FJsonObjectWrapper FGetActorsInLevelCommand::Execute(const TSharedPtr<FJsonObject>& Params)
+FEditorCommandResult FGetActorsInLevelCommand::ExecuteTyped(const FInstancedStruct& Params)
 {
-	FGetActorsInLevelCommandResponse Response;
+	TArray<FEditorCommandInvocation> Invocations;
+	Invocations.Add({nullptr, &Params});
+	return ExecuteBatch(Invocations)[0];
+}
 
-	UWorld* EditorWorld = nullptr;
-	if (GEditor)
+TArray<FEditorCommandResult> FGetActorsInLevelCommand::ExecuteBatch(const TArray<FEditorCommandInvocation>& Invocations)
+{
+	// Synchronous callers run the resumable pass to completion in one go
+	const TUniquePtr<IEditorCommandTask> Task = Begin(Invocations);
+	while (Task->Step(TNumericLimits<double>::Max()) == EEditorCommandStepResult::Continue)
 	{
-		EditorWorld = GEditor->GetEditorWorldContext().World();
 	}
+	return Task->Finish();
+}
 
-	if (EditorWorld)
+namespace
+{
+	/**
+	 * Resumable pass over the editor world answering one or more actor queries
+	 */
+	class FGetActorsInLevelTask : public IEditorCommandTask
 	{
-		TArray<AActor*> AllActors;
-		UGameplayStatics::GetAllActorsOfClass(EditorWorld, AActor::StaticClass(), AllActors);
+	public:
+		explicit FGetActorsInLevelTask(const TArray<FEditorCommandInvocation>& Invocations)
+		{
+			const int32 NumQueries = Invocations.Num();
+			Responses.SetNum(NumQueries);
+			Filters.SetNum(NumQueries);
+			ActiveQueries.Reserve(NumQueries);
+
+			// 1. Resolve every query's filter (decoded and validated before queueing); queries whose
+			//    class does not exist are answered without scanning
+			for (int32 Index = 0; Index < NumQueries; ++Index)
+			{
+				const FInstancedStruct* TypedParams = Invocations[Index].TypedParams;
+				FString Error = TEXT("Parameters were not decoded");
+				if (TypedParams && FActorQueryFilter::Resolve(TypedParams->Get<FGetActorsInLevelCommandParams>(), Filters[Index], Error))
+				{
+					ActiveQueries.Add(Index);
+				}
+				else
+				{
+					Responses[Index].success = false;
+					Responses[Index].error = Error;
+				}
+			}
+
+			UWorld* EditorWorld = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
+			if (!EditorWorld)
+			{
+				for (const int32 QueryIndex : ActiveQueries)
+				{
+					Responses[QueryIndex].success = false;
+					Responses[QueryIndex].error = TEXT("No editor world available");
+				}
+				ActiveQueries.Reset();
+				return;
+			}
+
+			// 2. Snapshot the actors to visit; the steps re-validate each one, since the level may
+			//    change between frames
+			if (ActiveQueries.Num() > 0)
+			{
+				for (TActorIterator<AActor> It(EditorWorld); It; ++It)
+				{
+					Actors.Add(*It);
+				}
+			}
+		}
+
+		virtual EEditorCommandStepResult Step(const double BudgetSeconds) override
+		{
+			// Reading the clock per actor would cost as much as cheap filters, so check it in strides
+			constexpr int32 ActorsPerClockCheck = 64;
+			const double EndTime = FPlatformTime::Seconds() + BudgetSeconds;
+
+			while (NextActorIndex < Actors.Num())
+			{
+				if (const AActor* Actor = Actors[NextActorIndex].Get())
+				{
+					VisitActor(Actor);
+				}
+				++NextActorIndex;
+
+				if (NextActorIndex % ActorsPerClockCheck == 0 && FPlatformTime::Seconds() >= EndTime)
+				{
+					return EEditorCommandStepResult::Continue;
+				}
+			}
+
+			return EEditorCommandStepResult::Done;
+		}
 
-		for (AActor* Actor : AllActors)
+		virtual TArray<FEditorCommandResult> Finish() override
 		{
-			if (!Actor) continue;
+			for (const int32 QueryIndex : ActiveQueries)
+			{
+				Responses[QueryIndex].success = true;
+				Responses[QueryIndex].count = Responses[QueryIndex].actors.Num();
+			}
+
+			// Split results into per-request outputs
+			TArray<FEditorCommandResult> Results;
+			Results.Reserve(Responses.Num());
+			for (FGetActorsInLevelCommandResponse& Response : Responses)
+			{
+				Results.Add(FEditorCommandResult::Make(MoveTemp(Response)));
+			}
+			return Results;
+		}
 
-			FMCPActorInfo ActorInfo = BuildActorInfo(Actor);
-			Response.actors.Add(ActorInfo);
+	private:
+		// Evaluate every query's filter for one actor, building its info at most once
+		void VisitActor(const AActor* Actor)
+		{
+			TOptional<FMCPActorInfo> ActorInfo;
+			for (const int32 QueryIndex : ActiveQueries)
+			{
+				if (!Filters[QueryIndex].Matches(Actor))
+				{
+					continue;
+				}
+
+				if (!ActorInfo.IsSet())
+				{
+					ActorInfo = FMCPWorldSnapshotBuilder::BuildActorInfo(Actor);
+				}
+				Responses[QueryIndex].actors.Add(ActorInfo.GetValue());
+			}
 		}
 
-		Response.success = true;
-		Response.count = Response.actors.Num();
-	}
-	else
+		TArray<FGetActorsInLevelCommandResponse> Responses;
+		TArray<FActorQueryFilter> Filters;
+		TArray<int32> ActiveQueries;
+
+		TArray<TWeakObjectPtr<AActor>> Actors;
+		int32 NextActorIndex = 0;
+	};
+}
+
+TUniquePtr<IEditorCommandTask> FGetActorsInLevelCommand::Begin(const TArray<FEditorCommandInvocation>& Invocations)
+{
+	return MakeUnique<FGetActorsInLevelTask>(Invocations);
+}
+
+bool FGetActorsInLevelCommand::CanExecuteOnSnapshot(const FMCPWorldSnapshot& Snapshot, const FEditorCommandInvocation& Invocation) const
+{
+	// Params were validated before this is called; only classes the snapshot does not know need the game thread
+	FActorQueryFilter Filter;
+	return Invocation.TypedParams &&
+		FActorQueryFilter::ResolveForSnapshot(Invocation.TypedParams->Get<FGetActorsInLevelCommandParams>(), Snapshot, Filter);
+}
+
+FEditorCommandResult FGetActorsInLevelCommand::ExecuteOnSnapshot(const FMCPWorldSnapshot& Snapshot,
+                                                                 const FEditorCommandInvocation& Invocation) const
+{
+	FGetActorsInLevelCommandResponse Response;
+	Response.snapshotRevision = static_cast<int64>(Snapshot.Revision);
+
+	FActorQueryFilter Filter;
+	if (!Invocation.TypedParams ||
+		!FActorQueryFilter::ResolveForSnapshot(Invocation.TypedParams->Get<FGetActorsInLevelCommandParams>(), Snapshot, Filter))
 	{
 		Response.success = false;
-		Response.error = TEXT("No editor world available");
+		Response.error = TEXT("Query cannot be answered from the world snapshot");
+		return FEditorCommandResult::Make(MoveTemp(Response));
 	}
 
-	FJsonObjectWrapper Wrapper;
-	Wrapper.JsonObject = FJsonObjectConverter::UStructToJsonObject(Response);
-	return Wrapper;
-}
+	for (const TSharedRef<const FMCPSnapshotActor>& Actor : Snapshot.Actors)
+	{
+		if (Filter.Matches(Snapshot, *Actor))
+		{
+			Response.actors.Add(Actor->Info);
+		}
+	}
 
-FMCPActorInfo FGetActorsInLevelCommand::BuildActorInfo(AActor* Actor) const
-{
-	FMCPActorInfo ActorInfo;
-	ActorInfo.name = Actor->GetName();
-	ActorInfo.className = Actor->GetClass()->GetName();
-
-	// Location
-	FVector Location = Actor->GetActorLocation();
-	ActorInfo.location.x = Location.X;
-	ActorInfo.location.y = Location.Y;
-	ActorInfo.location.z = Location.Z;
-
-	// Rotation
-	FRotator Rotation = Actor->GetActorRotation();
-	ActorInfo.rotation.pitch = Rotation.Pitch;
-	ActorInfo.rotation.yaw = Rotation.Yaw;
-	ActorInfo.rotation.roll = Rotation.Roll;
-
-	// Scale
-	FVector Scale = Actor->GetActorScale3D();
-	ActorInfo.scale.x = Scale.X;
-	ActorInfo.scale.y = Scale.Y;
-	ActorInfo.scale.z = Scale.Z;
-
-	return ActorInfo;
+	Response.success = true;
+	Response.count = Response.actors.Num();
+	return FEditorCommandResult::Make(MoveTemp(Response));
 }
@@ -3,15 +3,19 @@
 #pragma once
 
 #include "CoreMinimal.h"
-#include "IEditorCommand.h"
+#include "EditorCommandParams.h"
 
-class AActor;
 
 /**
- * GetActorsInLevel command - Retrieves all actors in the current editor level
+ * GetActorsInLevel command - Retrieves actors in the current editor level
  * Returns actor information including name, class, location, rotation, and scale
+ * Parameters: optional actor filter (see FActorQueryFilter), decoded and validated before queueing
+ * Concurrent queries are merged by the scheduler and answered with a single pass over the world.
+ * The pass is resumable: actors are snapshotted as weak pointers and filtered in budgeted steps,
+ * so large levels do not hitch a single frame.
+ * When the world snapshot is up to date, queries are answered from it on a worker thread instead.
  */
-class FGetActorsInLevelCommand : public IEditorCommand
+class FGetActorsInLevelCommand : public TTypedEditorCommand<FGetActorsInLevelCommandParams>
 {
 public:
 	virtual ~FGetActorsInLevelCommand() override = default;
@@ -19,14 +23,12 @@ public:
 	// IEditorCommand interface
 	virtual FString GetName() const override;
 	virtual FString GetDescription() const override;
-	virtual TArray<FCommandParameter> GetParameters() const override;
-	virtual FJsonObjectWrapper Execute(const TSharedPtr<FJsonObject>& Params) override;
-
-private:
-	/**
-	 * Build actor info struct for a single actor
-	 * @param Actor Actor to convert
-	 * @return Actor information struct
-	 */
-	struct FMCPActorInfo BuildActorInfo(AActor* Actor) const;
+	virtual bool DecodeParams(const TSharedPtr<FJsonObject>& Params, FInstancedStruct& OutParams, FString& OutError) const override;
+	virtual FEditorCommandResult ExecuteTyped(const FInstancedStruct& Params) override;
+	virtual bool SupportsBatchExecution() const override { return true; }
+	virtual TArray<FEditorCommandResult> ExecuteBatch(const TArray<FEditorCommandInvocation>& Invocations) override;
+	virtual bool IsCacheable() const override { return true; }
+	virtual TUniquePtr<IEditorCommandTask> Begin(const TArray<FEditorCommandInvocation>& Invocations) override;
+	virtual bool CanExecuteOnSnapshot(const FMCPWorldSnapshot& Snapshot, const FEditorCommandInvocation& Invocation) const override;
+	virtual FEditorCommandResult ExecuteOnSnapshot(const FMCPWorldSnapshot& Snapshot, const FEditorCommandInvocation& Invocation) const override;
 };
@@ -1,5 +1,92 @@
 // Fill out your copyright notice in the Description page of Project Settings.
 
 #include "IEditorCommand.h"
+#include "EditorCommandParams.h"
+#include "JsonObjectConverter.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
 
-// IEditorCommand is a pure interface with no implementation
+namespace
+{
+	// String properties marked meta = (MCPRawJson) already hold JSON and are embedded as values
+	const FName RawJsonMetaDataKey(TEXT("MCPRawJson"));
+
+	TSharedPtr<FJsonValue> ExportRawJsonProperty(FProperty* Property, const void* Value)
+	{
+		const FStrProperty* StrProperty = CastField<FStrProperty>(Property);
+		if (!StrProperty || !StrProperty->HasMetaData(RawJsonMetaDataKey))
+		{
+			return nullptr;
+		}
+
+		const FString& Json = StrProperty->GetPropertyValue(Value);
+		TSharedPtr<FJsonValue> JsonValue;
+		if (Json.IsEmpty() || !FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Json), JsonValue) || !JsonValue.IsValid())
+		{
+			return MakeShared<FJsonValueNull>();
+		}
+		return JsonValue;
+	}
+}
+
+FJsonObjectWrapper FEditorCommandResult::ToJsonObjectWrapper() const
+{
+	FJsonObjectWrapper Wrapper;
+	if (Data.IsValid())
+	{
+		const FJsonObjectConverter::CustomExportCallback ExportCallback =
+			FJsonObjectConverter::CustomExportCallback::CreateStatic(&ExportRawJsonProperty);
+
+		Wrapper.JsonObject = MakeShared<FJsonObject>();
+		FJsonObjectConverter::UStructToJsonObject(Data.GetScriptStruct(), Data.GetMemory(), Wrapper.JsonObject.ToSharedRef(),
+		                                          0, 0, &ExportCallback);
+	}
+	return Wrapper;
+}
+
+const TCHAR* LexToString(const EEditorCommandPriority Priority)
+{
+	switch (Priority)
+	{
+	case EEditorCommandPriority::Control:
+		return TEXT("control");
+	case EEditorCommandPriority::Interactive:
+		return TEXT("interactive");
+	case EEditorCommandPriority::Bulk:
+		return TEXT("bulk");
+	default:
+		return TEXT("unknown");
+	}
+}
+
+bool LexTryParseString(EEditorCommandPriority& OutPriority, const TCHAR* Name)
+{
+	for (uint8 Index = 0; Index < static_cast<uint8>(EEditorCommandPriority::Num); ++Index)
+	{
+		const EEditorCommandPriority Priority = static_cast<EEditorCommandPriority>(Index);
+		if (FCString::Stricmp(Name, LexToString(Priority)) == 0)
+		{
+			OutPriority = Priority;
+			return true;
+		}
+	}
+	return false;
+}
+
+bool IEditorCommand::DecodeParams(const TSharedPtr<FJsonObject>& Params, FInstancedStruct& OutParams, FString& OutError) const
+{
+	return FEditorCommandParams::Decode(Params, GetParamsStruct(), OutParams, OutError);
+}
+
+TArray<FEditorCommandResult> IEditorCommand::ExecuteBatch(const TArray<FEditorCommandInvocation>& Invocations)
+{
+	TArray<FEditorCommandResult> Results;
+	Results.Reserve(Invocations.Num());
+
+	for (const FEditorCommandInvocation& Invocation : Invocations)
+	{
+		Results.Add(Invocation.TypedParams ? ExecuteTyped(*Invocation.TypedParams) : Execute(Invocation.Params));
+	}
+
+	return Results;
+}
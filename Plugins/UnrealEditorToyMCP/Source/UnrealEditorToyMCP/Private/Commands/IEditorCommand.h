@@ -6,6 +6,9 @@
 #include "Dom/JsonObject.h"
 #include "Dom/JsonValue.h"
 #include "JsonObjectWrapper.h"
+#include "StructUtils/InstancedStruct.h"
+
+class FMCPWorldSnapshot;
 
 /**
  * Parameter definition for a command
@@ -27,6 +30,122 @@ struct FCommandParameter
 	}
 };
 
+/**
+ * Result of a command execution
+ * Holds the command's response USTRUCT as plain data. Commands produce it on the game thread;
+ * conversion to JSON is left to the dispatch layer, which does it on a worker thread.
+ */
+struct FEditorCommandResult
+{
+	FInstancedStruct Data;
+
+	/**
+	 * Wrap a response USTRUCT
+	 * @param Struct Response struct (moved into the result)
+	 * @return Command result holding the struct
+	 */
+	template<typename StructType>
+	static FEditorCommandResult Make(StructType Struct)
+	{
+		FEditorCommandResult Result;
+		Result.Data.InitializeAs<StructType>(MoveTemp(Struct));
+		return Result;
+	}
+
+	/**
+	 * Convert the response struct to a JSON object
+	 * Safe to call from any thread
+	 * @return FJsonObjectWrapper with the converted struct (empty if no data)
+	 */
+	FJsonObjectWrapper ToJsonObjectWrapper() const;
+};
+
+/**
+ * Outcome of one step of a resumable command
+ */
+enum class EEditorCommandStepResult : uint8
+{
+	// More work remains; step again on a later frame
+	Continue,
+	// All work is done; Finish may be called
+	Done
+};
+
+/**
+ * One pending invocation of a command, as handed to Begin, ExecuteBatch and the snapshot path
+ */
+struct FEditorCommandInvocation
+{
+	TSharedPtr<FJsonObject> Params;
+
+	// Decoded params (only for commands that declare a params struct, otherwise null)
+	const FInstancedStruct* TypedParams = nullptr;
+};
+
+/**
+ * In-progress execution of a resumable command
+ * Created by IEditorCommand::Begin and stepped on the game thread, possibly across many frames.
+ * The editor keeps running between steps, so a task must only hold weak references to
+ * editor objects and re-validate them in every step.
+ */
+class IEditorCommandTask
+{
+public:
+	virtual ~IEditorCommandTask() = default;
+
+	/**
+	 * Do a slice of the work
+	 * @param BudgetSeconds Game thread time this step should stay within
+	 * @return Continue if more work remains, Done otherwise
+	 */
+	virtual EEditorCommandStepResult Step(double BudgetSeconds) = 0;
+
+	/**
+	 * Produce the results after the last step returned Done
+	 * @return One result per invocation passed to Begin, in the same order
+	 */
+	virtual TArray<FEditorCommandResult> Finish() = 0;
+
+	/**
+	 * Check whether the task may give up its lane between steps
+	 * Tasks that can run for minutes (yielding scripts) return true, so the requests queued behind
+	 * them keep being served; the scheduler then steps the task in turn with those requests.
+	 * @return True to park the task after a step that returns Continue
+	 */
+	virtual bool YieldsLane() const { return false; }
+};
+
+/**
+ * Scheduling class of a command
+ * Each class has its own queue; the scheduler drains them with different weights per frame.
+ */
+enum class EEditorCommandPriority : uint8
+{
+	// Cheap commands that must never wait behind other work (status, cancel); drained completely every frame
+	Control,
+	// Short queries issued while an agent is waiting for the answer
+	Interactive,
+	// Long-running or large edits (scripts, bulk operations)
+	Bulk,
+
+	Num
+};
+
+/**
+ * Convert a priority to its lowercase name ("control", "interactive", "bulk")
+ * @param Priority Priority to convert
+ * @return Priority name
+ */
+const TCHAR* LexToString(EEditorCommandPriority Priority);
+
+/**
+ * Parse a priority name (case-insensitive)
+ * @param Name Priority name
+ * @param OutPriority Parsed priority
+ * @return True if the name is a valid priority
+ */
+bool LexTryParseString(EEditorCommandPriority& OutPriority, const TCHAR* Name);
+
 /**
  * Base interface for all editor commands
  * Implements the Command pattern for extensible command handling
@@ -50,14 +169,121 @@ public:
 
 	/**
 	 * Get parameter definitions for this command
+	 * Called once at registration; the registry keeps the resulting schema
 	 * @return Array of parameter definitions
 	 */
 	virtual TArray<FCommandParameter> GetParameters() const = 0;
 
+	/**
+	 * Get the USTRUCT this command's parameters are decoded into
+	 * When set, the dispatch layer decodes and validates the request body with DecodeParams before
+	 * queueing the command, and calls ExecuteTyped instead of Execute.
+	 * @return Params struct, or nullptr for commands that read the JSON object themselves
+	 */
+	virtual const UScriptStruct* GetParamsStruct() const { return nullptr; }
+
+	/**
+	 * Decode and validate JSON params into GetParamsStruct()
+	 * Called where the request is received and must be thread-safe. The default implementation
+	 * decodes the struct by reflection and checks its required fields; override to validate more.
+	 * @param Params JSON object containing command parameters (may be null)
+	 * @param OutParams Decoded params struct
+	 * @param OutError Error message when decoding or validation fails
+	 * @return True if the params are valid
+	 */
+	virtual bool DecodeParams(const TSharedPtr<FJsonObject>& Params, FInstancedStruct& OutParams, FString& OutError) const;
+
 	/**
 	 * Execute the command with given parameters
+	 * Called on the game thread; should only produce the result, not serialize it
 	 * @param Params JSON object containing command parameters
-	 * @return FJsonObjectWrapper with command result
+	 * @return Command result (response USTRUCT)
+	 */
+	virtual FEditorCommandResult Execute(const TSharedPtr<FJsonObject>& Params) = 0;
+
+	/**
+	 * Execute the command with params already decoded into GetParamsStruct()
+	 * Only called for commands that declare a params struct (see TTypedEditorCommand)
+	 * @param Params Decoded and validated params struct
+	 * @return Command result (response USTRUCT)
 	 */
-	virtual FJsonObjectWrapper Execute(const TSharedPtr<FJsonObject>& Params) = 0;
+	virtual FEditorCommandResult ExecuteTyped(const FInstancedStruct& Params) { return FEditorCommandResult(); }
+
+	/**
+	 * Check if pending invocations of this command may be merged into one ExecuteBatch call
+	 * @return True if the scheduler should batch this command
+	 */
+	virtual bool SupportsBatchExecution() const { return false; }
+
+	/**
+	 * Execute several pending invocations of this command at once
+	 * Override to share work between invocations (e.g. a single pass over the world).
+	 * The default implementation calls ExecuteTyped (or Execute, without decoded params) for each entry.
+	 * @param Invocations Pending invocations
+	 * @return One result per entry in Invocations, in the same order
+	 */
+	virtual TArray<FEditorCommandResult> ExecuteBatch(const TArray<FEditorCommandInvocation>& Invocations);
+
+	/**
+	 * Check if responses of this command may be served from the result cache
+	 * Only read-only commands whose result depends on params and editor state alone should opt in.
+	 * @return True if the command is cacheable
+	 */
+	virtual bool IsCacheable() const { return false; }
+
+	/**
+	 * Check if this command may change editor state
+	 * Executing such a command invalidates the result cache, and snapshot reads wait until it has
+	 * completed and the world snapshot has caught up. Read-only commands that cannot be cached
+	 * (status, progress queries) should return false.
+	 * @return True if the command may edit the editor state
+	 */
+	virtual bool ModifiesEditor() const { return !IsCacheable(); }
+
+	/**
+	 * Check if this command may edit actors without the editor's change delegates reporting it
+	 * The world snapshot only follows edits that broadcast a change (e.g. PostEditMove, PostEditChange);
+	 * it is rebuilt after commands that return true, such as scripts calling the unreal API directly.
+	 * @return True if the world snapshot must be rebuilt after the command
+	 */
+	virtual bool HasUntrackedEdits() const { return false; }
+
+	/**
+	 * Get the scheduling class of this command
+	 * Clients may lower it per request with the X-MCP-Priority header, but never raise it to control.
+	 * @return Priority of the command
+	 */
+	virtual EEditorCommandPriority GetPriority() const { return EEditorCommandPriority::Interactive; }
+
+	/**
+	 * Start a resumable execution
+	 * Commands that touch many objects should return a task, so the scheduler can spread the work
+	 * over several frames within the MCP frame budget instead of hitching a single frame.
+	 * @param Invocations Pending invocations (more than one only for batchable commands);
+	 *                    they stay valid until the task has finished
+	 * @return Task to step, or nullptr to run Execute/ExecuteBatch in a single call instead
+	 */
+	virtual TUniquePtr<IEditorCommandTask> Begin(const TArray<FEditorCommandInvocation>& Invocations) { return nullptr; }
+
+	/**
+	 * Check whether a request can be answered from the world snapshot instead of the game thread
+	 * Called where the request is received. Read-only commands that only need actor metadata
+	 * override this together with ExecuteOnSnapshot.
+	 * @param Snapshot Latest world snapshot
+	 * @param Invocation Request params (already decoded and validated for commands with a params struct)
+	 * @return True to answer the request with ExecuteOnSnapshot
+	 */
+	virtual bool CanExecuteOnSnapshot(const FMCPWorldSnapshot& Snapshot, const FEditorCommandInvocation& Invocation) const { return false; }
+
+	/**
+	 * Answer a request from the world snapshot
+	 * Called on a worker thread; must not touch UObjects
+	 * @param Snapshot World snapshot CanExecuteOnSnapshot accepted
+	 * @param Invocation Request params
+	 * @return Command result (response USTRUCT)
+	 */
+	virtual FEditorCommandResult ExecuteOnSnapshot(const FMCPWorldSnapshot& Snapshot, const FEditorCommandInvocation& Invocation) const
+	{
+		return FEditorCommandResult();
+	}
 };
@@ -1,7 +1,6 @@
 // Fill out your copyright notice in the Description page of Project Settings.
 
 #include "PingCommand.h"
-#include "JsonObjectConverter.h"
 #include "MCPJsonStructs.h"
 
 FString FPingCommand::GetName() const
@@ -20,12 +19,10 @@ TArray<FCommandParameter> FPingCommand::GetParameters() const
 	return TArray<FCommandParameter>();
 }
 
-FJsonObjectWrapper FPingCommand::Execute(const TSharedPtr<FJsonObject>& Params)
+FEditorCommandResult FPingCommand::Execute(const TSharedPtr<FJsonObject>& Params)
 {
 	FPingCommandResponse Response;
 	Response.message = TEXT("pong");
 
-	FJsonObjectWrapper Wrapper;
-	Wrapper.JsonObject = FJsonObjectConverter::UStructToJsonObject(Response);
-	return Wrapper;
+	return FEditorCommandResult::Make(MoveTemp(Response));
 }
@@ -18,5 +18,7 @@ public:
 	virtual FString GetName() const override;
 	virtual FString GetDescription() const override;
 	virtual TArray<FCommandParameter> GetParameters() const override;
-	virtual FJsonObjectWrapper Execute(const TSharedPtr<FJsonObject>& Params) override;
+	virtual FEditorCommandResult Execute(const TSharedPtr<FJsonObject>& Params) override;
+	virtual EEditorCommandPriority GetPriority() const override { return EEditorCommandPriority::Control; }
+	virtual bool ModifiesEditor() const override { return false; }
 };
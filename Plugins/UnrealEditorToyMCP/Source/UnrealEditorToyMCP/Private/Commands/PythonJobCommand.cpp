@@ -0,0 +1,63 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "PythonJobCommand.h"
+#include "MCPJsonStructs.h"
+#include "Python/MCPPythonJobs.h"
+
+FPythonJobCommand::FPythonJobCommand(const TSharedRef<FMCPPythonJobRegistry>& InJobs)
+	: Jobs(InJobs)
+{
+}
+
+FString FPythonJobCommand::GetName() const
+{
+	return TEXT("python_job");
+}
+
+FString FPythonJobCommand::GetDescription() const
+{
+	return TEXT("List running execute_python jobs with their progress, or cancel one");
+}
+
+FEditorCommandResult FPythonJobCommand::ExecuteWithParams(const FPythonJobCommandParams& Params)
+{
+	FPythonJobCommandResponse Response;
+
+	// 1. list: every job in progress
+	if (Params.action == TEXT("list"))
+	{
+		for (const TSharedRef<FMCPPythonJob>& Job : Jobs->GetAll())
+		{
+			Response.jobs.Add(Job->ToInfo());
+		}
+
+		Response.success = true;
+		return FEditorCommandResult::Make(MoveTemp(Response));
+	}
+
+	if (Params.action != TEXT("cancel"))
+	{
+		Response.success = false;
+		Response.error = FString::Printf(TEXT("Unknown action '%s' (expected list or cancel)"), *Params.action);
+
+		return FEditorCommandResult::Make(MoveTemp(Response));
+	}
+
+	// 2. cancel: flag the job, it stops at its next yield
+	const TSharedPtr<FMCPPythonJob> Job = Jobs->Find(Params.job_id);
+	if (!Job)
+	{
+		Response.success = false;
+		Response.error = Params.job_id.IsEmpty()
+			                 ? TEXT("Action 'cancel' requires job_id")
+			                 : FString::Printf(TEXT("No running job '%s'"), *Params.job_id);
+
+		return FEditorCommandResult::Make(MoveTemp(Response));
+	}
+
+	Job->bCancelRequested = true;
+
+	Response.success = true;
+	Response.jobs.Add(Job->ToInfo());
+	return FEditorCommandResult::Make(MoveTemp(Response));
+}
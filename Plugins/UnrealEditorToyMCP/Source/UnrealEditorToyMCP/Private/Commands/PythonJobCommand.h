@@ -0,0 +1,37 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EditorCommandParams.h"
+
+class FMCPPythonJobRegistry;
+
+/**
+ * PythonJob command - Reports and cancels execute_python scripts that yield across frames
+ * Runs in the control lane, so it is answered between the steps of a running job.
+ * Cancellation only flags the job; the script stops at its next yield (its finally blocks run)
+ * and its execute_python request completes with cancelled set.
+ * Parameters:
+ *   - action (required): "list" or "cancel"
+ *   - job_id (optional): Job the action applies to (required for cancel)
+ */
+class FPythonJobCommand : public TTypedEditorCommand<FPythonJobCommandParams>
+{
+public:
+	explicit FPythonJobCommand(const TSharedRef<FMCPPythonJobRegistry>& InJobs);
+	virtual ~FPythonJobCommand() override = default;
+
+	// IEditorCommand interface
+	virtual FString GetName() const override;
+	virtual FString GetDescription() const override;
+	virtual EEditorCommandPriority GetPriority() const override { return EEditorCommandPriority::Control; }
+	virtual bool ModifiesEditor() const override { return false; }
+
+protected:
+	// TTypedEditorCommand interface
+	virtual FEditorCommandResult ExecuteWithParams(const FPythonJobCommandParams& Params) override;
+
+private:
+	TSharedRef<FMCPPythonJobRegistry> Jobs;
+};
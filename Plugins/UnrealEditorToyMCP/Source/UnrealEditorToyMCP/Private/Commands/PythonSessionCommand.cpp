@@ -0,0 +1,92 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "PythonSessionCommand.h"
+#include "IPythonScriptPlugin.h"
+#include "JsonObjectConverter.h"
+#include "MCPJsonStructs.h"
+#include "Python/MCPPythonLibrary.h"
+
+namespace
+{
+	// Statement evaluated for every action; the action itself is fetched through UMCPPythonLibrary
+	const TCHAR* ManageSessionsStatement = TEXT("__import__('mcp_runtime').manage_sessions()");
+}
+
+FString FPythonSessionCommand::GetName() const
+{
+	return TEXT("python_session");
+}
+
+FString FPythonSessionCommand::GetDescription() const
+{
+	return TEXT("List, reset or close persistent execute_python sessions");
+}
+
+FEditorCommandResult FPythonSessionCommand::ExecuteWithParams(const FPythonSessionCommandParams& Params)
+{
+	FPythonSessionCommandResponse Response;
+
+	// 1. Validate the action
+	const bool bTargetsSession = Params.action == TEXT("reset") || Params.action == TEXT("close");
+	if (!bTargetsSession && Params.action != TEXT("list") && Params.action != TEXT("close_all"))
+	{
+		Response.success = false;
+		Response.error = FString::Printf(TEXT("Unknown action '%s' (expected list, reset, close or close_all)"), *Params.action);
+
+		return FEditorCommandResult::Make(MoveTemp(Response));
+	}
+
+	if (bTargetsSession && Params.session_id.IsEmpty())
+	{
+		Response.success = false;
+		Response.error = FString::Printf(TEXT("Action '%s' requires session_id"), *Params.action);
+
+		return FEditorCommandResult::Make(MoveTemp(Response));
+	}
+
+	// 2. Check Python availability
+	IPythonScriptPlugin* PythonScriptPlugin = IPythonScriptPlugin::Get();
+	if (!PythonScriptPlugin || !PythonScriptPlugin->IsPythonAvailable())
+	{
+		Response.success = false;
+		Response.error = TEXT("Python is not available (is the Python Editor Script Plugin enabled?)");
+
+		return FEditorCommandResult::Make(MoveTemp(Response));
+	}
+
+	// 3. Let mcp_runtime apply the action (it also evicts idle sessions)
+	FMCPPythonInvocation Invocation;
+	Invocation.SessionId = Params.session_id;
+	Invocation.SessionAction = Params.action;
+
+	FPythonCommandEx PythonCommand;
+	PythonCommand.Command = ManageSessionsStatement;
+	PythonCommand.ExecutionMode = EPythonCommandExecutionMode::EvaluateStatement;
+	PythonCommand.Flags |= EPythonCommandFlags::Unattended;
+
+	bool bSucceeded;
+	{
+		FMCPPythonInvocationScope InvocationScope(Invocation);
+		bSucceeded = PythonScriptPlugin->ExecPythonCommandEx(PythonCommand);
+	}
+
+	if (!bSucceeded)
+	{
+		Response.success = false;
+		Response.error = PythonCommand.CommandResult;
+
+		return FEditorCommandResult::Make(MoveTemp(Response));
+	}
+
+	// 4. Build response from the state mcp_runtime reported
+	if (!FJsonObjectConverter::JsonArrayStringToUStruct(Invocation.SessionsJson, &Response.sessions))
+	{
+		Response.success = false;
+		Response.error = TEXT("mcp_runtime did not report the session state");
+
+		return FEditorCommandResult::Make(MoveTemp(Response));
+	}
+
+	Response.success = true;
+	return FEditorCommandResult::Make(MoveTemp(Response));
+}
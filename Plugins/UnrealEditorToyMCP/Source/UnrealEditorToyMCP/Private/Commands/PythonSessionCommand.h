@@ -0,0 +1,32 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EditorCommandParams.h"
+
+/**
+ * PythonSession command - Inspects and manages execute_python sessions
+ * Sessions live in the mcp_runtime Python module; this command asks it to apply an action and
+ * report the sessions' state, including an estimate of the memory their namespaces hold.
+ * Sessions are runtime state, not editor state: the command runs in the interactive lane (not
+ * behind a running bulk job) and neither invalidates cached results nor holds back snapshot reads.
+ * Parameters:
+ *   - action (required): "list", "reset" (fresh namespace, same id), "close" or "close_all"
+ *   - session_id (optional): Session the action applies to (required for reset and close)
+ */
+class FPythonSessionCommand : public TTypedEditorCommand<FPythonSessionCommandParams>
+{
+public:
+	virtual ~FPythonSessionCommand() override = default;
+
+	// IEditorCommand interface
+	virtual FString GetName() const override;
+	virtual FString GetDescription() const override;
+	virtual EEditorCommandPriority GetPriority() const override { return EEditorCommandPriority::Interactive; }
+	virtual bool ModifiesEditor() const override { return false; }
+
+protected:
+	// TTypedEditorCommand interface
+	virtual FEditorCommandResult ExecuteWithParams(const FPythonSessionCommandParams& Params) override;
+};
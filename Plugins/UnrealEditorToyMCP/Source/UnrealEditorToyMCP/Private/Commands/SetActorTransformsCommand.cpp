@@ -0,0 +1,312 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "SetActorTransformsCommand.h"
+#include "ActorTransformBatch.h"
+#include "BulkEditTask.h"
+#include "Editor.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GameFramework/Actor.h"
+#include "MCPJsonStructs.h"
+
+#define LOCTEXT_NAMESPACE "SetActorTransformsCommand"
+
+FString FSetActorTransformsCommand::GetName() const
+{
+	return TEXT("set_actor_transforms");
+}
+
+FString FSetActorTransformsCommand::GetDescription() const
+{
+	return TEXT("Set the location, rotation and/or scale of many actors as one undo transaction");
+}
+
+namespace
+{
+	/**
+	 * One requested move, in either input format
+	 * Components that are not set keep the actor's current value.
+	 */
+	struct FTransformEdit
+	{
+		FGuid Id;
+		TOptional<FVector> Location;
+		TOptional<FVector> Rotation;
+		TOptional<FVector> Scale;
+	};
+
+	bool ParseRowComponent(const TArray<double>& Values, const int32 Index, const TCHAR* Name, TOptional<FVector>& OutValue,
+	                       FString& OutError)
+	{
+		if (Values.Num() == 0)
+		{
+			return true;
+		}
+		if (Values.Num() != 3)
+		{
+			OutError = FString::Printf(TEXT("actors[%d].%s must have 3 numbers"), Index, Name);
+			return false;
+		}
+
+		OutValue = FVector(Values[0], Values[1], Values[2]);
+		return true;
+	}
+
+	bool ParseColumn(const TArray<double>& Values, const TCHAR* Name, TOptional<FVector> FTransformEdit::* Component,
+	                 TArray<FTransformEdit>& Edits, FString& OutError)
+	{
+		if (Values.Num() == 0)
+		{
+			return true;
+		}
+		if (Values.Num() != Edits.Num() * 3)
+		{
+			OutError = FString::Printf(TEXT("'%s' must have 3 numbers per id (%d), got %d"), Name, Edits.Num() * 3, Values.Num());
+			return false;
+		}
+
+		for (int32 Index = 0; Index < Edits.Num(); ++Index)
+		{
+			Edits[Index].*Component = FVector(Values[Index * 3], Values[Index * 3 + 1], Values[Index * 3 + 2]);
+		}
+		return true;
+	}
+
+	bool ParseEdits(const FSetActorTransformsCommandParams& Params, TArray<FTransformEdit>& OutEdits, FString& OutError)
+	{
+		const bool bRows = Params.actors.Num() > 0;
+		const bool bColumns = Params.ids.Num() > 0;
+		if (bRows == bColumns)
+		{
+			OutError = bRows ? TEXT("Pass either 'actors' (rows) or 'ids' (columns), not both") : TEXT("Either 'actors' or 'ids' is required");
+			return false;
+		}
+
+		// 1. Rows: one object per actor
+		if (bRows)
+		{
+			OutEdits.SetNum(Params.actors.Num());
+			for (int32 Index = 0; Index < Params.actors.Num(); ++Index)
+			{
+				const FMCPActorTransformItem& Item = Params.actors[Index];
+				FTransformEdit& Edit = OutEdits[Index];
+				if (!FGuid::Parse(Item.id, Edit.Id))
+				{
+					OutError = FString::Printf(TEXT("Invalid actor id at actors[%d]: %s"), Index, *Item.id);
+					return false;
+				}
+				if (!ParseRowComponent(Item.location, Index, TEXT("location"), Edit.Location, OutError) ||
+					!ParseRowComponent(Item.rotation, Index, TEXT("rotation"), Edit.Rotation, OutError) ||
+					!ParseRowComponent(Item.scale, Index, TEXT("scale"), Edit.Scale, OutError))
+				{
+					return false;
+				}
+			}
+			return true;
+		}
+
+		// 2. Columns: ids plus one flat array per component
+		OutEdits.SetNum(Params.ids.Num());
+		for (int32 Index = 0; Index < Params.ids.Num(); ++Index)
+		{
+			if (!FGuid::Parse(Params.ids[Index], OutEdits[Index].Id))
+			{
+				OutError = FString::Printf(TEXT("Invalid actor id at ids[%d]: %s"), Index, *Params.ids[Index]);
+				return false;
+			}
+		}
+		return ParseColumn(Params.locations, TEXT("locations"), &FTransformEdit::Location, OutEdits, OutError) &&
+			ParseColumn(Params.rotations, TEXT("rotations"), &FTransformEdit::Rotation, OutEdits, OutError) &&
+			ParseColumn(Params.scales, TEXT("scales"), &FTransformEdit::Scale, OutEdits, OutError);
+	}
+
+	/**
+	 * Resumable move of every requested actor
+	 * The first step resolves all ids in one pass over the world; the moves are then applied in
+	 * strides between clock checks, and the editor is notified once after the last one.
+	 */
+	class FSetActorTransformsTask : public TBulkEditTask<FSetActorTransformsCommandParams, FSetActorTransformsCommandResponse>
+	{
+	public:
+		explicit FSetActorTransformsTask(const FSetActorTransformsCommandParams& InParams)
+			: TBulkEditTask(InParams, LOCTEXT("SetActorTransforms", "MCP: Set Actor Transforms"))
+		{
+			FString Error;
+			if (!ParseEdits(Params, Edits, Error))
+			{
+				Response.error = Error;
+			}
+		}
+
+		virtual ~FSetActorTransformsTask() override
+		{
+			// Abandoned mid-move (server shutdown): still tell the editor about the actors already moved
+			Batch.Finish();
+		}
+
+		virtual EEditorCommandStepResult Step(const double BudgetSeconds) override
+		{
+			if (AbortIfInterrupted())
+			{
+				// The actors moved before the interruption are still reported and notified
+				Response.moved = Batch.Num();
+				Batch.Finish();
+				return EEditorCommandStepResult::Done;
+			}
+			if (!Response.error.IsEmpty())
+			{
+				return EEditorCommandStepResult::Done;
+			}
+
+			const double StartTime = FPlatformTime::Seconds();
+			const double EndTime = StartTime + BudgetSeconds;
+			++Response.steps;
+
+			// 1. Resolve every id at once
+			if (Targets.Num() == 0)
+			{
+				if (!Resolve())
+				{
+					return EEditorCommandStepResult::Done;
+				}
+				Response.timings.resolveMs += ToMilliseconds(FPlatformTime::Seconds() - StartTime);
+			}
+
+			// 2. Move in strides; the clock is read rarely, since a move is cheap without notifications
+			constexpr int32 ActorsPerClockCheck = 64;
+			const double ApplyStartTime = FPlatformTime::Seconds();
+			Transaction.Begin();
+
+			while (NextIndex < Edits.Num())
+			{
+				ApplyEdit(NextIndex);
+				++NextIndex;
+
+				if (NextIndex % ActorsPerClockCheck == 0 && FPlatformTime::Seconds() >= EndTime)
+				{
+					Response.timings.applyMs += ToMilliseconds(FPlatformTime::Seconds() - ApplyStartTime);
+					return EEditorCommandStepResult::Continue;
+				}
+			}
+
+			const double NotifyStartTime = FPlatformTime::Seconds();
+			Response.timings.applyMs += ToMilliseconds(NotifyStartTime - ApplyStartTime);
+
+			// 3. Notify the editor once for the whole batch and close the undo step
+			Response.moved = Batch.Num();
+			Batch.Finish();
+			Transaction.End();
+			Response.timings.notifyMs = ToMilliseconds(FPlatformTime::Seconds() - NotifyStartTime);
+
+			return EEditorCommandStepResult::Done;
+		}
+
+		virtual TArray<FEditorCommandResult> Finish() override
+		{
+			if (Response.error.IsEmpty() && Response.errors.Num() > 0)
+			{
+				Response.error = FString::Printf(TEXT("%d of %d actors could not be moved"), Response.errors.Num(), Edits.Num());
+			}
+			Response.success = Response.error.IsEmpty();
+			return {FEditorCommandResult::Make(MoveTemp(Response))};
+		}
+
+	private:
+		// Find the actor of every edit in one pass over the world
+		bool Resolve()
+		{
+			const UWorld* EditorWorld = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
+			if (!EditorWorld)
+			{
+				Response.error = TEXT("No editor world available");
+				return false;
+			}
+
+			Targets.SetNum(Edits.Num());
+
+			TMap<FGuid, int32> IndexById;
+			IndexById.Reserve(Edits.Num());
+			for (int32 Index = 0; Index < Edits.Num(); ++Index)
+			{
+				if (IndexById.Contains(Edits[Index].Id))
+				{
+					AddError(Index, FString::Printf(TEXT("Duplicate actor id %s"), *Edits[Index].Id.ToString(EGuidFormats::DigitsWithHyphens)));
+					continue;
+				}
+				IndexById.Add(Edits[Index].Id, Index);
+			}
+
+			int32 NumFound = 0;
+			for (TActorIterator<AActor> It(EditorWorld); It && NumFound < IndexById.Num(); ++It)
+			{
+				if (const int32* Index = IndexById.Find(It->GetActorGuid()))
+				{
+					Targets[*Index] = *It;
+					++NumFound;
+				}
+			}
+
+			if (NumFound < IndexById.Num())
+			{
+				for (const TPair<FGuid, int32>& Entry : IndexById)
+				{
+					if (Targets[Entry.Value].IsExplicitlyNull())
+					{
+						AddError(Entry.Value, FString::Printf(TEXT("No actor with id %s"), *Entry.Key.ToString(EGuidFormats::DigitsWithHyphens)));
+					}
+				}
+				Response.errors.Sort([](const FMCPItemError& A, const FMCPItemError& B) { return A.index < B.index; });
+			}
+			return true;
+		}
+
+		void ApplyEdit(const int32 Index)
+		{
+			const TWeakObjectPtr<AActor>& Target = Targets[Index];
+			if (Target.IsExplicitlyNull())
+			{
+				// Already reported by Resolve
+				return;
+			}
+
+			AActor* Actor = Target.Get();
+			if (!Actor)
+			{
+				AddError(Index, TEXT("Actor was deleted before it could be moved"));
+				return;
+			}
+
+			const FTransformEdit& Edit = Edits[Index];
+			FTransform Transform = Actor->GetActorTransform();
+			if (Edit.Location.IsSet())
+			{
+				Transform.SetLocation(Edit.Location.GetValue());
+			}
+			if (Edit.Rotation.IsSet())
+			{
+				const FVector& Rotation = Edit.Rotation.GetValue();
+				Transform.SetRotation(FRotator(Rotation.X, Rotation.Y, Rotation.Z).Quaternion());
+			}
+			if (Edit.Scale.IsSet())
+			{
+				Transform.SetScale3D(Edit.Scale.GetValue());
+			}
+			Batch.Apply(*Actor, Transform);
+		}
+
+		TArray<FTransformEdit> Edits;
+
+		// Actor of each edit (explicitly null if it was not found)
+		TArray<TWeakObjectPtr<AActor>> Targets;
+		int32 NextIndex = 0;
+
+		FActorTransformBatch Batch;
+	};
+}
+
+TUniquePtr<IEditorCommandTask> FSetActorTransformsCommand::BeginWithParams(const FSetActorTransformsCommandParams& Params)
+{
+	return MakeUnique<FSetActorTransformsTask>(Params);
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,32 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EditorCommandParams.h"
+
+/**
+ * SetActorTransforms command - Moves many actors in one request
+ * Ids are resolved in a single pass over the world, the moves are applied in strides across frames
+ * inside one undo transaction, and the editor's move notifications (OnActorsMoved, navigation,
+ * property windows, viewport redraw) are sent once at the end (see FActorTransformBatch).
+ * The response reports the time spent resolving, applying and notifying.
+ * Parameters (one format or the other):
+ *   - actors (optional): Rows of {id, location, rotation, scale}, each component an optional [x, y, z]
+ *   - ids (optional): Actor GUIDs for the columnar format
+ *   - locations / rotations / scales (optional): Flat arrays of 3 numbers per id (omitted = keep)
+ */
+class FSetActorTransformsCommand : public TTypedEditorCommand<FSetActorTransformsCommandParams>
+{
+public:
+	virtual ~FSetActorTransformsCommand() override = default;
+
+	// IEditorCommand interface
+	virtual FString GetName() const override;
+	virtual FString GetDescription() const override;
+	virtual EEditorCommandPriority GetPriority() const override { return EEditorCommandPriority::Bulk; }
+
+protected:
+	// TTypedEditorCommand interface
+	virtual TUniquePtr<IEditorCommandTask> BeginWithParams(const FSetActorTransformsCommandParams& Params) override;
+};
@@ -0,0 +1,455 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "SetPropertiesCommand.h"
+#include "ActorSelection.h"
+#include "BulkEditTask.h"
+#include "Editor.h"
+#include "EditorSupportDelegates.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "JsonObjectConverter.h"
+#include "MCPJsonStructs.h"
+
+#define LOCTEXT_NAMESPACE "SetPropertiesCommand"
+
+FString FSetPropertiesCommand::GetName() const
+{
+	return TEXT("set_properties");
+}
+
+FString FSetPropertiesCommand::GetDescription() const
+{
+	return TEXT("Set editable properties on many actors (selected by id or filter) as one undo transaction");
+}
+
+namespace
+{
+	/**
+	 * One step of a property path
+	 * Object properties lead into the object they point to (a component of the actor), struct
+	 * properties into the struct's memory.
+	 */
+	struct FPropertyLink
+	{
+		FProperty* Property = nullptr;
+
+		// Class of the object the link pointed to when the path was resolved (object links only)
+		const UClass* ObjectClass = nullptr;
+	};
+
+	/**
+	 * A property path resolved against one actor (cached for its class when valid)
+	 */
+	struct FPropertyChain
+	{
+		TArray<FPropertyLink> Links;
+
+		// Why the path cannot be set on the actor it was resolved against (empty if valid)
+		FString Error;
+	};
+
+	/**
+	 * Where one property path of one actor is written
+	 */
+	struct FPropertyTarget
+	{
+		// Object owning the written memory (the actor or one of its components)
+		UObject* Owner = nullptr;
+
+		// Property of Owner that contains the value (the struct when Leaf is inside one)
+		FProperty* MemberProperty = nullptr;
+
+		FProperty* Leaf = nullptr;
+		void* Value = nullptr;
+	};
+
+	FPropertyChain ResolveChain(AActor& Actor, const FString& Path)
+	{
+		FPropertyChain Chain;
+
+		TArray<FString> Segments;
+		Path.ParseIntoArray(Segments, TEXT("."));
+		if (Segments.Num() == 0)
+		{
+			Chain.Error = TEXT("Empty property path");
+			return Chain;
+		}
+
+		const UStruct* Struct = Actor.GetClass();
+		void* Container = &Actor;
+		for (int32 Index = 0; Index < Segments.Num(); ++Index)
+		{
+			FProperty* Property = FindFProperty<FProperty>(Struct, *Segments[Index]);
+			if (!Property)
+			{
+				Chain.Error = FString::Printf(TEXT("%s has no property '%s'"), *Struct->GetName(), *Segments[Index]);
+				return Chain;
+			}
+
+			FPropertyLink& Link = Chain.Links.Add_GetRef({Property});
+			if (Index == Segments.Num() - 1)
+			{
+				// As in the details panel: EditDefaultsOnly properties are not editable on level instances
+				if (!Property->HasAnyPropertyFlags(CPF_Edit) || Property->HasAnyPropertyFlags(CPF_EditConst | CPF_DisableEditOnInstance))
+				{
+					Chain.Error = FString::Printf(TEXT("'%s' is not an editable property of %s"), *Path, *Actor.GetClass()->GetName());
+				}
+				break;
+			}
+
+			void* Value = Property->ContainerPtrToValuePtr<void>(Container);
+			if (const FObjectPropertyBase* ObjectProperty = CastField<FObjectPropertyBase>(Property))
+			{
+				// Only into the actor's own components: a path must never edit a shared asset
+				UObject* Object = ObjectProperty->GetObjectPropertyValue(Value);
+				if (!Object || !Object->IsIn(&Actor))
+				{
+					Chain.Error = FString::Printf(TEXT("'%s' does not lead to a component of the actor"), *Segments[Index]);
+					return Chain;
+				}
+				Link.ObjectClass = Object->GetClass();
+				Struct = Object->GetClass();
+				Container = Object;
+			}
+			else if (const FStructProperty* StructProperty = CastField<FStructProperty>(Property))
+			{
+				Struct = StructProperty->Struct;
+				Container = Value;
+			}
+			else
+			{
+				Chain.Error = FString::Printf(TEXT("'%s' is neither a component nor a struct"), *Segments[Index]);
+				return Chain;
+			}
+		}
+		return Chain;
+	}
+
+	// Follow a chain on an actor; false if the actor's components differ from the ones it was resolved with
+	bool FindTarget(AActor& Actor, const FPropertyChain& Chain, FPropertyTarget& OutTarget)
+	{
+		UObject* Owner = &Actor;
+		void* Container = &Actor;
+		FProperty* MemberProperty = nullptr;
+		for (int32 Index = 0; Index < Chain.Links.Num(); ++Index)
+		{
+			const FPropertyLink& Link = Chain.Links[Index];
+			if (!MemberProperty)
+			{
+				MemberProperty = Link.Property;
+			}
+
+			void* Value = Link.Property->ContainerPtrToValuePtr<void>(Container);
+			if (Index == Chain.Links.Num() - 1)
+			{
+				OutTarget = {Owner, MemberProperty, Link.Property, Value};
+				return true;
+			}
+
+			if (Link.ObjectClass)
+			{
+				UObject* Object = CastFieldChecked<FObjectPropertyBase>(Link.Property)->GetObjectPropertyValue(Value);
+				if (!Object || Object->GetClass() != Link.ObjectClass || !Object->IsIn(&Actor))
+				{
+					return false;
+				}
+				Owner = Object;
+				Container = Object;
+				MemberProperty = nullptr;
+			}
+			else
+			{
+				Container = Value;
+			}
+		}
+		return false;
+	}
+
+	/**
+	 * A JSON value converted once into a property's native representation
+	 */
+	class FPropertyValue : public FNoncopyable
+	{
+	public:
+		FPropertyValue(FProperty& InProperty, const TSharedPtr<FJsonValue>& JsonValue)
+			: Property(InProperty)
+			  , Memory(FMemory::Malloc(InProperty.GetSize(), InProperty.GetMinAlignment()))
+		{
+			Property.InitializeValue(Memory);
+			bValid = FJsonObjectConverter::JsonValueToUProperty(JsonValue, &Property, Memory);
+		}
+
+		~FPropertyValue()
+		{
+			Property.DestroyValue(Memory);
+			FMemory::Free(Memory);
+		}
+
+		bool IsValid() const { return bValid; }
+		bool IsIdentical(const void* Value) const { return Property.Identical(Value, Memory, PPF_None); }
+		void CopyTo(void* Value) const { Property.CopyCompleteValue(Value, Memory); }
+
+	private:
+		FProperty& Property;
+		void* Memory;
+		bool bValid = false;
+	};
+
+	/**
+	 * A value to write into one actor
+	 */
+	struct FPendingWrite
+	{
+		FPropertyTarget Target;
+		const FPropertyValue* Value = nullptr;
+	};
+
+	/**
+	 * Resumable edit of every selected actor
+	 * The first step resolves the selection; actors are then edited in strides between clock
+	 * checks inside one editor transaction, and the editor UI is refreshed after the last one.
+	 */
+	class FSetPropertiesTask : public TBulkEditTask<FSetPropertiesCommandParams, FSetPropertiesCommandResponse>
+	{
+	public:
+		explicit FSetPropertiesTask(const FSetPropertiesCommandParams& InParams)
+			: TBulkEditTask(InParams, LOCTEXT("SetProperties", "MCP: Set Properties"))
+		{
+			Response.dry_run = Params.dry_run;
+
+			if (!Params.properties.JsonObject.IsValid() || Params.properties.JsonObject->Values.Num() == 0)
+			{
+				Response.error = TEXT("'properties' must name at least one property");
+			}
+		}
+
+		virtual EEditorCommandStepResult Step(const double BudgetSeconds) override
+		{
+			if (AbortIfInterrupted() || !Response.error.IsEmpty())
+			{
+				return EEditorCommandStepResult::Done;
+			}
+
+			const double StartTime = FPlatformTime::Seconds();
+			const double EndTime = StartTime + BudgetSeconds;
+			++Response.steps;
+
+			// 1. Resolve the selection once
+			if (!bResolved)
+			{
+				if (!Resolve())
+				{
+					return EEditorCommandStepResult::Done;
+				}
+				bResolved = true;
+				Response.timings.resolveMs = ToMilliseconds(FPlatformTime::Seconds() - StartTime);
+			}
+
+			// 2. Edit in strides
+			constexpr int32 ActorsPerClockCheck = 32;
+			const double ApplyStartTime = FPlatformTime::Seconds();
+			if (!Params.dry_run)
+			{
+				Transaction.Begin();
+			}
+
+			while (NextIndex < Actors.Num())
+			{
+				if (AActor* Actor = Actors[NextIndex].Get())
+				{
+					EditActor(*Actor, NextIndex);
+				}
+				else if (!Actors[NextIndex].IsExplicitlyNull())
+				{
+					AddError(NextIndex, TEXT("Actor was deleted before it could be edited"));
+				}
+				++NextIndex;
+
+				if (NextIndex % ActorsPerClockCheck == 0 && FPlatformTime::Seconds() >= EndTime)
+				{
+					Response.timings.applyMs += ToMilliseconds(FPlatformTime::Seconds() - ApplyStartTime);
+					return EEditorCommandStepResult::Continue;
+				}
+			}
+
+			const double NotifyStartTime = FPlatformTime::Seconds();
+			Response.timings.applyMs += ToMilliseconds(NotifyStartTime - ApplyStartTime);
+
+			// 3. Refresh the editor once for the whole batch and close the undo step
+			if (!Params.dry_run && Response.changed > 0)
+			{
+				FEditorSupportDelegates::RefreshPropertyWindows.Broadcast();
+				FEditorSupportDelegates::UpdateUI.Broadcast();
+				if (GEditor)
+				{
+					GEditor->RedrawLevelEditingViewports();
+				}
+			}
+			Transaction.End();
+			Response.timings.notifyMs = ToMilliseconds(FPlatformTime::Seconds() - NotifyStartTime);
+
+			return EEditorCommandStepResult::Done;
+		}
+
+		virtual TArray<FEditorCommandResult> Finish() override
+		{
+			if (Response.error.IsEmpty() && Response.errors.Num() > 0)
+			{
+				Response.error = FString::Printf(TEXT("%d actors could not be edited"), Response.errors.Num());
+			}
+			Response.success = Response.error.IsEmpty();
+			return {FEditorCommandResult::Make(MoveTemp(Response))};
+		}
+
+	private:
+		bool Resolve()
+		{
+			UWorld* EditorWorld = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
+			if (!EditorWorld)
+			{
+				Response.error = TEXT("No editor world available");
+				return false;
+			}
+
+			TArray<AActor*> Selected;
+			if (!FActorSelection::Resolve(*EditorWorld, Params.ids, Params.selector, Selected, Response.errors, Response.error))
+			{
+				return false;
+			}
+
+			Actors.Reserve(Selected.Num());
+			for (AActor* Actor : Selected)
+			{
+				Actors.Add(Actor);
+				Response.matched += Actor ? 1 : 0;
+			}
+			return true;
+		}
+
+		void EditActor(AActor& Actor, const int32 Index)
+		{
+			// 1. Find where each value goes; only the values that differ are written
+			Pending.Reset();
+			for (const TPair<FString, TSharedPtr<FJsonValue>>& Entry : Params.properties.JsonObject->Values)
+			{
+				FPropertyTarget Target;
+				FString Error;
+				if (!FindActorTarget(Actor, Entry.Key, Target, Error))
+				{
+					AddError(Index, FString::Printf(TEXT("%s: %s"), *Actor.GetActorLabel(), *Error));
+					return;
+				}
+
+				const FPropertyValue& Value = FindValue(*Target.Leaf, Entry.Key, Entry.Value);
+				if (!Value.IsValid())
+				{
+					AddError(Index, FString::Printf(TEXT("%s: invalid value for property '%s'"), *Actor.GetActorLabel(), *Entry.Key));
+					return;
+				}
+				if (!Value.IsIdentical(Target.Value))
+				{
+					Pending.Add({Target, &Value});
+				}
+			}
+
+			if (Pending.Num() == 0)
+			{
+				++Response.unchanged;
+				return;
+			}
+			++Response.changed;
+			if (Params.dry_run)
+			{
+				return;
+			}
+
+			// 2. Write, notifying each edited object once. A single changed property is reported as
+			//    such; several are reported as a generic edit of the object
+			Pending.StableSort([](const FPendingWrite& A, const FPendingWrite& B) { return A.Target.Owner < B.Target.Owner; });
+			for (int32 First = 0; First < Pending.Num();)
+			{
+				UObject* Owner = Pending[First].Target.Owner;
+				FProperty* MemberProperty = Pending[First].Target.MemberProperty;
+				int32 End = First + 1;
+				for (; End < Pending.Num() && Pending[End].Target.Owner == Owner; ++End)
+				{
+					if (Pending[End].Target.MemberProperty != MemberProperty)
+					{
+						MemberProperty = nullptr;
+					}
+				}
+
+				Owner->Modify();
+				Owner->PreEditChange(MemberProperty);
+				for (int32 WriteIndex = First; WriteIndex < End; ++WriteIndex)
+				{
+					Pending[WriteIndex].Value->CopyTo(Pending[WriteIndex].Target.Value);
+				}
+				FPropertyChangedEvent ChangedEvent(MemberProperty, EPropertyChangeType::ValueSet);
+				Owner->PostEditChangeProperty(ChangedEvent);
+
+				First = End;
+			}
+		}
+
+		// Follow a path on an actor, with the chain resolved once per actor class
+		bool FindActorTarget(AActor& Actor, const FString& Path, FPropertyTarget& OutTarget, FString& OutError)
+		{
+			const TPair<const UClass*, FString> Key(Actor.GetClass(), Path);
+			if (const FPropertyChain* Chain = ChainCache.Find(Key))
+			{
+				if (FindTarget(Actor, *Chain, OutTarget))
+				{
+					return true;
+				}
+			}
+
+			// Not cached yet, or the actor's components differ from the ones the cached chain was
+			// resolved with (instance edits): resolve for this actor. Only valid chains are cached,
+			// since errors such as a missing component depend on the actor instance
+			FPropertyChain ActorChain = ResolveChain(Actor, Path);
+			if (!ActorChain.Error.IsEmpty())
+			{
+				OutError = MoveTemp(ActorChain.Error);
+				return false;
+			}
+			if (!FindTarget(Actor, ActorChain, OutTarget))
+			{
+				OutError = FString::Printf(TEXT("'%s' could not be resolved on the actor"), *Path);
+				return false;
+			}
+			ChainCache.FindOrAdd(Key) = MoveTemp(ActorChain);
+			return true;
+		}
+
+		// Convert a JSON value for a property once, however many actors it is written to
+		const FPropertyValue& FindValue(FProperty& Property, const FString& Path, const TSharedPtr<FJsonValue>& JsonValue)
+		{
+			const TPair<const FProperty*, FString> Key(&Property, Path);
+			if (const TUniquePtr<FPropertyValue>* Value = ValueCache.Find(Key))
+			{
+				return **Value;
+			}
+			return *ValueCache.Add(Key, MakeUnique<FPropertyValue>(Property, JsonValue));
+		}
+
+		// Selected actors (explicitly null for ids that were not found)
+		TArray<TWeakObjectPtr<AActor>> Actors;
+		bool bResolved = false;
+		int32 NextIndex = 0;
+
+		// Resolution caches, so each valid path is resolved once per class and each value converted once
+		TMap<TPair<const UClass*, FString>, FPropertyChain> ChainCache;
+		TMap<TPair<const FProperty*, FString>, TUniquePtr<FPropertyValue>> ValueCache;
+
+		// Writes of the actor being edited (kept to reuse the allocation)
+		TArray<FPendingWrite> Pending;
+	};
+}
+
+TUniquePtr<IEditorCommandTask> FSetPropertiesCommand::BeginWithParams(const FSetPropertiesCommandParams& Params)
+{
+	return MakeUnique<FSetPropertiesTask>(Params);
+}
+
+#undef LOCTEXT_NAMESPACE
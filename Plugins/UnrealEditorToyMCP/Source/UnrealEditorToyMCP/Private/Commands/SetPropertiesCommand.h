@@ -0,0 +1,33 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EditorCommandParams.h"
+
+/**
+ * SetProperties command - Sets editable properties on many actors in one request
+ * Property paths are resolved once per actor class and each value is converted from JSON once,
+ * then copied into every actor. Actors that already have the values are skipped; the others are
+ * written in one undo transaction with one PreEditChange/PostEditChangeProperty per edited object
+ * (actor or component), however many of its properties change, and the editor UI is refreshed
+ * once at the end.
+ * Parameters:
+ *   - properties (required): {"PropertyPath": value}, e.g. {"StaticMeshComponent.CastShadow": false}
+ *   - ids / selector (one or the other): Actor GUIDs, or an actor filter (see FActorSelection)
+ *   - dry_run (optional): Only count the actors that would change
+ */
+class FSetPropertiesCommand : public TTypedEditorCommand<FSetPropertiesCommandParams>
+{
+public:
+	virtual ~FSetPropertiesCommand() override = default;
+
+	// IEditorCommand interface
+	virtual FString GetName() const override;
+	virtual FString GetDescription() const override;
+	virtual EEditorCommandPriority GetPriority() const override { return EEditorCommandPriority::Bulk; }
+
+protected:
+	// TTypedEditorCommand interface
+	virtual TUniquePtr<IEditorCommandTask> BeginWithParams(const FSetPropertiesCommandParams& Params) override;
+};
@@ -0,0 +1,391 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "SpawnActorsCommand.h"
+#include "ActorFactories/ActorFactory.h"
+#include "AssetRegistry/AssetData.h"
+#include "AssetSelection.h"
+#include "BulkEditTask.h"
+#include "Editor.h"
+#include "Engine/Blueprint.h"
+#include "Engine/Level.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "JsonObjectConverter.h"
+#include "MCPJsonStructs.h"
+#include "UObject/ObjectKey.h"
+
+#define LOCTEXT_NAMESPACE "SpawnActorsCommand"
+
+FString FSpawnActorsCommand::GetName() const
+{
+	return TEXT("spawn_actors");
+}
+
+FString FSpawnActorsCommand::GetDescription() const
+{
+	return TEXT("Spawn many actors (by class or asset) into the current level as one undo transaction");
+}
+
+namespace
+{
+	/**
+	 * What items with the same class_name or asset are spawned from
+	 * Held weakly across frames: the editor may collect the asset or reinstance a recompiled
+	 * Blueprint class between steps.
+	 */
+	struct FSpawnTemplate
+	{
+		// Class of the spawned actors
+		TWeakObjectPtr<UClass> ActorClass;
+
+		// Asset and its actor factory (asset items only)
+		TWeakObjectPtr<UObject> Asset;
+		TWeakObjectPtr<UActorFactory> Factory;
+
+		// Why nothing can be spawned from it (empty if valid)
+		FString Error;
+
+		// Check whether a resolved template lost its objects (error templates are never stale)
+		bool IsStale() const
+		{
+			if (!Error.IsEmpty())
+			{
+				return false;
+			}
+			const UClass* Class = ActorClass.Get();
+			return !Class || Class->HasAnyClassFlags(CLASS_NewerVersionExists) ||
+				(!Asset.IsExplicitlyNull() && (!Asset.IsValid() || !Factory.IsValid()));
+		}
+	};
+
+	FSpawnTemplate ResolveClassTemplate(const FString& ClassName)
+	{
+		FSpawnTemplate Template;
+		UClass* ActorClass;
+
+		// Paths may name a Blueprint asset instead of its generated class
+		if (ClassName.Contains(TEXT("/")))
+		{
+			UObject* Object = LoadObject<UObject>(nullptr, *ClassName);
+			const UBlueprint* Blueprint = Cast<UBlueprint>(Object);
+			ActorClass = Blueprint ? Blueprint->GeneratedClass.Get() : Cast<UClass>(Object);
+		}
+		else
+		{
+			ActorClass = FindFirstObject<UClass>(*ClassName, EFindFirstObjectOptions::NativeFirst);
+		}
+
+		if (!ActorClass || !ActorClass->IsChildOf(AActor::StaticClass()))
+		{
+			Template.Error = FString::Printf(TEXT("Unknown actor class: %s"), *ClassName);
+		}
+		else if (ActorClass->HasAnyClassFlags(CLASS_Abstract | CLASS_Deprecated | CLASS_NotPlaceable))
+		{
+			Template.Error = FString::Printf(TEXT("Actor class %s cannot be placed"), *ClassName);
+		}
+		Template.ActorClass = ActorClass;
+		return Template;
+	}
+
+	FSpawnTemplate ResolveAssetTemplate(const FString& AssetPath)
+	{
+		FSpawnTemplate Template;
+
+		UObject* Asset = LoadObject<UObject>(nullptr, *AssetPath);
+		if (!Asset)
+		{
+			Template.Error = FString::Printf(TEXT("Unknown asset: %s"), *AssetPath);
+			return Template;
+		}
+
+		UActorFactory* Factory = FActorFactoryAssetProxy::GetFactoryForAssetObject(Asset);
+		Template.Asset = Asset;
+		Template.Factory = Factory;
+		Template.ActorClass = Factory ? Factory->GetDefaultActorClass(FAssetData(Asset)) : nullptr;
+		if (!Template.ActorClass.IsValid())
+		{
+			Template.Error = FString::Printf(TEXT("No actor factory can place asset %s"), *AssetPath);
+		}
+		return Template;
+	}
+
+	/**
+	 * Resumable spawn of every requested actor
+	 * Spawns in strides between clock checks; one editor transaction is held open from the first
+	 * step to the last, so the whole request is a single undo step (abandoned tasks keep what they
+	 * placed, still undoable as one step).
+	 */
+	class FSpawnActorsTask : public TBulkEditTask<FSpawnActorsCommandParams, FSpawnActorsCommandResponse>
+	{
+	public:
+		explicit FSpawnActorsTask(const FSpawnActorsCommandParams& InParams)
+			: TBulkEditTask(InParams, LOCTEXT("SpawnActors", "MCP: Spawn Actors"))
+		{
+			Response.ids.SetNum(Params.actors.Num());
+
+			const UWorld* EditorWorld = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
+			if (!EditorWorld)
+			{
+				Response.error = TEXT("No editor world available");
+				return;
+			}
+			Level = EditorWorld->GetCurrentLevel();
+		}
+
+		virtual EEditorCommandStepResult Step(const double BudgetSeconds) override
+		{
+			if (AbortIfInterrupted() || !Response.error.IsEmpty())
+			{
+				return EEditorCommandStepResult::Done;
+			}
+
+			// 1. The level may have been unloaded between frames
+			ULevel* SpawnLevel = Level.Get();
+			if (!SpawnLevel)
+			{
+				Response.error = FString::Printf(TEXT("The editor level changed while spawning (%d of %d actors placed)"),
+				                                 Response.spawned, Params.actors.Num());
+				Transaction.End();
+				return EEditorCommandStepResult::Done;
+			}
+
+			++Response.steps;
+			if (Transaction.Begin())
+			{
+				SpawnLevel->Modify();
+			}
+
+			// 2. Templates resolved in earlier steps may have been collected or reinstanced since
+			DropStaleTemplates();
+
+			// 3. Spawning dominates the cost of a stride, so the clock is read rarely
+			constexpr int32 ActorsPerClockCheck = 16;
+			const double EndTime = FPlatformTime::Seconds() + BudgetSeconds;
+
+			while (NextIndex < Params.actors.Num())
+			{
+				SpawnItem(*SpawnLevel, NextIndex);
+				++NextIndex;
+
+				if (NextIndex % ActorsPerClockCheck == 0 && FPlatformTime::Seconds() >= EndTime)
+				{
+					return EEditorCommandStepResult::Continue;
+				}
+			}
+
+			// 4. Close the undo step and redraw once for the whole batch
+			Transaction.End();
+			GEditor->RedrawLevelEditingViewports();
+			return EEditorCommandStepResult::Done;
+		}
+
+		virtual TArray<FEditorCommandResult> Finish() override
+		{
+			if (Response.error.IsEmpty() && Response.errors.Num() > 0)
+			{
+				Response.error = FString::Printf(TEXT("%d of %d actors could not be spawned"),
+				                                 Response.errors.Num(), Params.actors.Num());
+			}
+			Response.success = Response.error.IsEmpty();
+			return {FEditorCommandResult::Make(MoveTemp(Response))};
+		}
+
+	private:
+		void SpawnItem(ULevel& SpawnLevel, const int32 Index)
+		{
+			const FMCPActorSpawnItem& Item = Params.actors[Index];
+
+			// 1. Resolve what to spawn and which properties to write (cached per class and asset)
+			const FSpawnTemplate& Template = FindTemplate(Item);
+			if (!Template.Error.IsEmpty())
+			{
+				AddError(Index, Template.Error);
+				return;
+			}
+
+			UClass* ActorClass = Template.ActorClass.Get();
+			TArray<TPair<FProperty*, TSharedPtr<FJsonValue>>> Properties;
+			FString Error;
+			if (!ResolveProperties(ActorClass, Item.properties, Properties, Error))
+			{
+				AddError(Index, Error);
+				return;
+			}
+
+			const FTransform Transform(
+				FRotator(Item.rotation.pitch, Item.rotation.yaw, Item.rotation.roll),
+				FVector(Item.location.x, Item.location.y, Item.location.z),
+				FVector(Item.scale.x, Item.scale.y, Item.scale.z));
+
+			FActorSpawnParameters SpawnParams;
+			SpawnParams.OverrideLevel = &SpawnLevel;
+			SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+			SpawnParams.ObjectFlags = RF_Transactional;
+
+			// 2. Spawn. Class items defer construction so the properties are in place before the
+			//    construction script runs; factories finish construction themselves, so asset items
+			//    get their properties afterwards and are reconstructed once
+			AActor* Actor = nullptr;
+			bool bPropertiesWritten = true;
+			if (UActorFactory* Factory = Template.Factory.Get())
+			{
+				Actor = Factory->CreateActor(Template.Asset.Get(), &SpawnLevel, Transform, SpawnParams);
+				if (Actor && Properties.Num() > 0)
+				{
+					bPropertiesWritten = WriteProperties(*Actor, Properties, Error);
+					Actor->PostEditChange();
+				}
+			}
+			else
+			{
+				SpawnParams.bDeferConstruction = true;
+				Actor = SpawnLevel.GetWorld()->SpawnActor(ActorClass, &Transform, SpawnParams);
+				if (Actor)
+				{
+					bPropertiesWritten = WriteProperties(*Actor, Properties, Error);
+					Actor->FinishSpawning(Transform);
+				}
+			}
+
+			if (!Actor)
+			{
+				AddError(Index, TEXT("Spawning failed"));
+				return;
+			}
+			if (!bPropertiesWritten)
+			{
+				SpawnLevel.GetWorld()->EditorDestroyActor(Actor, false);
+				AddError(Index, Error);
+				return;
+			}
+
+			// 3. Outliner placement
+			if (!Item.label.IsEmpty())
+			{
+				Actor->SetActorLabel(Item.label);
+			}
+			if (!Item.folder.IsEmpty())
+			{
+				Actor->SetFolderPath(FName(*Item.folder));
+			}
+
+			Response.ids[Index] = Actor->GetActorGuid().ToString(EGuidFormats::DigitsWithHyphens);
+			++Response.spawned;
+		}
+
+		const FSpawnTemplate& FindTemplate(const FMCPActorSpawnItem& Item)
+		{
+			if (!Item.asset.IsEmpty())
+			{
+				if (const FSpawnTemplate* Template = AssetTemplates.Find(Item.asset))
+				{
+					return *Template;
+				}
+				return AssetTemplates.Add(Item.asset, ResolveAssetTemplate(Item.asset));
+			}
+
+			if (const FSpawnTemplate* Template = ClassTemplates.Find(Item.class_name))
+			{
+				return *Template;
+			}
+			if (Item.class_name.IsEmpty())
+			{
+				FSpawnTemplate Missing;
+				Missing.Error = TEXT("Either class_name or asset is required");
+				return ClassTemplates.Add(Item.class_name, MoveTemp(Missing));
+			}
+			return ClassTemplates.Add(Item.class_name, ResolveClassTemplate(Item.class_name));
+		}
+
+		// Forget templates and property lookups whose objects are gone, so they are resolved again
+		void DropStaleTemplates()
+		{
+			for (auto It = ClassTemplates.CreateIterator(); It; ++It)
+			{
+				if (It->Value.IsStale())
+				{
+					It.RemoveCurrent();
+				}
+			}
+			for (auto It = AssetTemplates.CreateIterator(); It; ++It)
+			{
+				if (It->Value.IsStale())
+				{
+					It.RemoveCurrent();
+				}
+			}
+			for (auto It = PropertyCache.CreateIterator(); It; ++It)
+			{
+				const UClass* Class = Cast<UClass>(It->Key.Key.ResolveObjectPtr());
+				if (!Class || Class->HasAnyClassFlags(CLASS_NewerVersionExists))
+				{
+					It.RemoveCurrent();
+				}
+			}
+		}
+
+		// Look up the editable properties an item sets (the lookup is cached per class)
+		bool ResolveProperties(const UClass* ActorClass, const FJsonObjectWrapper& Values,
+		                       TArray<TPair<FProperty*, TSharedPtr<FJsonValue>>>& OutProperties, FString& OutError)
+		{
+			if (!Values.JsonObject.IsValid())
+			{
+				return true;
+			}
+
+			for (const TPair<FString, TSharedPtr<FJsonValue>>& Value : Values.JsonObject->Values)
+			{
+				const TPair<FObjectKey, FString> Key(FObjectKey(ActorClass), Value.Key);
+				FProperty** Property = PropertyCache.Find(Key);
+				if (!Property)
+				{
+					FProperty* Found = FindFProperty<FProperty>(ActorClass, *Value.Key);
+					if (Found && (!Found->HasAnyPropertyFlags(CPF_Edit) || Found->HasAnyPropertyFlags(CPF_EditConst)))
+					{
+						Found = nullptr;
+					}
+					Property = &PropertyCache.Add(Key, Found);
+				}
+
+				if (!*Property)
+				{
+					OutError = FString::Printf(TEXT("'%s' is not an editable property of %s"), *Value.Key, *ActorClass->GetName());
+					return false;
+				}
+				OutProperties.Emplace(*Property, Value.Value);
+			}
+			return true;
+		}
+
+		static bool WriteProperties(AActor& Actor, const TArray<TPair<FProperty*, TSharedPtr<FJsonValue>>>& Properties,
+		                            FString& OutError)
+		{
+			for (const TPair<FProperty*, TSharedPtr<FJsonValue>>& Property : Properties)
+			{
+				if (!FJsonObjectConverter::JsonValueToUProperty(Property.Value, Property.Key,
+				                                                Property.Key->ContainerPtrToValuePtr<void>(&Actor)))
+				{
+					OutError = FString::Printf(TEXT("Invalid value for property '%s'"), *Property.Key->GetName());
+					return false;
+				}
+			}
+			return true;
+		}
+
+		TWeakObjectPtr<ULevel> Level;
+		int32 NextIndex = 0;
+
+		// Resolution caches, so each distinct class, asset and property is looked up once (per
+		// reinstancing); properties are keyed weakly by the class that owns them
+		TMap<FString, FSpawnTemplate> ClassTemplates;
+		TMap<FString, FSpawnTemplate> AssetTemplates;
+		TMap<TPair<FObjectKey, FString>, FProperty*> PropertyCache;
+	};
+}
+
+TUniquePtr<IEditorCommandTask> FSpawnActorsCommand::BeginWithParams(const FSpawnActorsCommandParams& Params)
+{
+	return MakeUnique<FSpawnActorsTask>(Params);
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,32 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EditorCommandParams.h"
+
+/**
+ * SpawnActors command - Places many actors in the current editor level in one request
+ * All actors are spawned into one undo transaction, which stays open across the frames the spawn
+ * is spread over. Class-based actors are spawned with deferred construction: properties are
+ * written before FinishSpawning, so the construction script and component registration run
+ * once per actor with the final values. Assets are placed through their actor factory.
+ * Classes, assets and properties are resolved once per request, not once per actor, and again only
+ * if the editor collects or reinstances them between frames.
+ * Parameters:
+ *   - actors (required): Array of {class_name | asset, location, rotation, scale, label, folder, properties}
+ */
+class FSpawnActorsCommand : public TTypedEditorCommand<FSpawnActorsCommandParams>
+{
+public:
+	virtual ~FSpawnActorsCommand() override = default;
+
+	// IEditorCommand interface
+	virtual FString GetName() const override;
+	virtual FString GetDescription() const override;
+	virtual EEditorCommandPriority GetPriority() const override { return EEditorCommandPriority::Bulk; }
+
+protected:
+	// TTypedEditorCommand interface
+	virtual TUniquePtr<IEditorCommandTask> BeginWithParams(const FSpawnActorsCommandParams& Params) override;
+};
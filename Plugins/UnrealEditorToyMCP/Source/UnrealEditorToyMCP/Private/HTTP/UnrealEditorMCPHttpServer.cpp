@@ -2,18 +2,39 @@
 
 #include "UnrealEditorMCPHttpServer.h"
 #include "Commands/EditorCommandRegistry.h"
+#include "Commands/EditorCommandScheduler.h"
 #include "Commands/PingCommand.h"
 #include "Commands/GetActorsInLevelCommand.h"
 #include "Commands/ExecutePythonCommand.h"
+#include "Commands/PythonJobCommand.h"
+#include "Commands/PythonSessionCommand.h"
+#include "Commands/SetActorTransformsCommand.h"
+#include "Commands/SetPropertiesCommand.h"
+#include "Commands/SpawnActorsCommand.h"
+#include "Commands/DeleteActorsCommand.h"
 #include "HttpServerModule.h"
 #include "Editor.h"                    // GEditor
+#include "Editor/EditorEngine.h"       // ShouldDisableCPUThrottlingDelegates
+#include "HAL/IConsoleManager.h"       // Console variables
 #include "Engine/World.h"              // UWorld
 #include "GameFramework/Actor.h"       // AActor
 #include "MCPJsonHelpers.h"            // JSON helper functions
-
-
-FUnrealEditorMCPHttpServer::FUnrealEditorMCPHttpServer()
-	: bIsRunning(false)
+#include "MCPMetrics.h"                // Request metrics
+#include "MCPTrace.h"                  // Insights trace scopes
+#include "MCPWorldSnapshot.h"          // World snapshot reads
+#include "Python/MCPPythonJobs.h"      // Python jobs in progress
+#include "UnrealEditorMCP.h"           // LogUnrealEditorMCP
+
+static TAutoConsoleVariable<float> CVarMCPKeepAwakeSeconds(
+	TEXT("mcp.KeepAwakeSeconds"),
+	5.0f,
+	TEXT("Seconds after the last MCP tool request during which the editor does not throttle its tick rate in the background. 0 = only while requests are pending."),
+	ECVF_Default);
+
+FUnrealEditorMCPHttpServer::FUnrealEditorMCPHttpServer(const TSharedRef<FMCPWorldSnapshotBuilder>& InWorldSnapshot)
+	: WorldSnapshot(InWorldSnapshot)
+	  , PythonJobs(MakeShared<FMCPPythonJobRegistry>())
+	  , bIsRunning(false)
 	  , ServerPort(0)
 {
 	// Initialize command registry
@@ -22,14 +43,28 @@ FUnrealEditorMCPHttpServer::FUnrealEditorMCPHttpServer()
 	// Register all commands
 	CommandRegistry->RegisterCommand(MakeShared<FPingCommand>());
 	CommandRegistry->RegisterCommand(MakeShared<FGetActorsInLevelCommand>());
-	CommandRegistry->RegisterCommand(MakeShared<FExecutePythonCommand>());
-
-	UE_LOG(LogTemp, Display, TEXT("UnrealEditorMCP: Registered %d commands"), CommandRegistry->GetCommandCount());
+	CommandRegistry->RegisterCommand(MakeShared<FExecutePythonCommand>(PythonJobs));
+	CommandRegistry->RegisterCommand(MakeShared<FPythonJobCommand>(PythonJobs));
+	CommandRegistry->RegisterCommand(MakeShared<FPythonSessionCommand>());
+	CommandRegistry->RegisterCommand(MakeShared<FSpawnActorsCommand>());
+	CommandRegistry->RegisterCommand(MakeShared<FSetActorTransformsCommand>());
+	CommandRegistry->RegisterCommand(MakeShared<FSetPropertiesCommand>());
+	CommandRegistry->RegisterCommand(MakeShared<FDeleteActorsCommand>());
+
+	UE_LOG(LogUnrealEditorMCP, Display, TEXT("UnrealEditorMCP: Registered %d commands"), CommandRegistry->GetCommandCount());
+
+	// Initialize metrics (one slot per registered command); snapshot refreshes count as MCP game thread time
+	Metrics = MakeShared<FMCPMetrics>(CommandRegistry->GetAllCommands());
+	WorldSnapshot->SetMetrics(Metrics);
+
+	// Initialize command scheduler (drains queued commands on the game thread)
+	CommandScheduler = MakeUnique<FEditorCommandScheduler>(CommandRegistry->GetResultCache(), Metrics.ToSharedRef(), WorldSnapshot);
 }
 
 FUnrealEditorMCPHttpServer::~FUnrealEditorMCPHttpServer()
 {
 	Stop();
+	WorldSnapshot->SetMetrics(nullptr);
 }
 
 
@@ -37,7 +72,7 @@ bool FUnrealEditorMCPHttpServer::Start(uint32 Port)
 {
 	if (bIsRunning)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("UnrealEditorMCP: HTTP Server already running"));
+		UE_LOG(LogUnrealEditorMCP, Warning, TEXT("UnrealEditorMCP: HTTP Server already running"));
 		return false;
 	}
 
@@ -50,7 +85,7 @@ bool FUnrealEditorMCPHttpServer::Start(uint32 Port)
 	HttpRouter = HttpServerModule.GetHttpRouter(ServerPort);
 	if (!HttpRouter.IsValid())
 	{
-		UE_LOG(LogTemp, Error, TEXT("UnrealEditorMCP: Failed to get HTTP router for port %d"), ServerPort);
+		UE_LOG(LogUnrealEditorMCP, Error, TEXT("UnrealEditorMCP: Failed to get HTTP router for port %d"), ServerPort);
 		return false;
 	}
 
@@ -60,12 +95,23 @@ bool FUnrealEditorMCPHttpServer::Start(uint32 Port)
 	// Start the listeners
 	HttpServerModule.StartAllListeners();
 
+	// Requests wait for editor ticks, so keep the editor from throttling while a client is active
+	if (GEditor)
+	{
+		FShouldDisableCPUThrottling ShouldDisableCPUThrottling =
+			FShouldDisableCPUThrottling::CreateRaw(this, &FUnrealEditorMCPHttpServer::ShouldDisableCPUThrottling);
+		CPUThrottlingHandle = ShouldDisableCPUThrottling.GetHandle();
+		GEditor->ShouldDisableCPUThrottlingDelegates.Add(MoveTemp(ShouldDisableCPUThrottling));
+	}
+
 	bIsRunning = true;
 
-	UE_LOG(LogTemp, Display, TEXT("UnrealEditorMCP: HTTP Server started on http://localhost:%d"), ServerPort);
-	UE_LOG(LogTemp, Display, TEXT("  GET  /mcp/tools         - List available tools"));
-	UE_LOG(LogTemp, Display, TEXT("  POST /mcp/tool/{name}   - Execute a tool"));
-	UE_LOG(LogTemp, Display, TEXT("  GET  /mcp/status        - Server status"));
+	UE_LOG(LogUnrealEditorMCP, Display, TEXT("UnrealEditorMCP: HTTP Server started on http://localhost:%d"), ServerPort);
+	UE_LOG(LogUnrealEditorMCP, Display, TEXT("  GET  /mcp/tools         - List available tools"));
+	UE_LOG(LogUnrealEditorMCP, Display, TEXT("  POST /mcp/tool/{name}   - Execute a tool"));
+	UE_LOG(LogUnrealEditorMCP, Display, TEXT("  GET  /mcp/status        - Server status"));
+	UE_LOG(LogUnrealEditorMCP, Display, TEXT("  GET  /mcp/metrics       - Request metrics (Prometheus)"));
+	UE_LOG(LogUnrealEditorMCP, Display, TEXT("  GET  /mcp/debug/requests - Recent request summaries"));
 
 	return true;
 }
@@ -87,16 +133,38 @@ void FUnrealEditorMCPHttpServer::Stop()
 		{
 			HttpRouter->UnbindRoute(ExecuteToolHandle);
 		}
+		for (const FHttpRouteHandle& ToolRouteHandle : ToolRouteHandles)
+		{
+			HttpRouter->UnbindRoute(ToolRouteHandle);
+		}
+		ToolRouteHandles.Empty();
 		if (StatusHandle.IsValid())
 		{
 			HttpRouter->UnbindRoute(StatusHandle);
 		}
+		if (MetricsHandle.IsValid())
+		{
+			HttpRouter->UnbindRoute(MetricsHandle);
+		}
+		if (DebugRequestsHandle.IsValid())
+		{
+			HttpRouter->UnbindRoute(DebugRequestsHandle);
+		}
 
 		HttpRouter.Reset();
 	}
 
+	if (GEditor && CPUThrottlingHandle.IsValid())
+	{
+		GEditor->ShouldDisableCPUThrottlingDelegates.RemoveAll([this](const FShouldDisableCPUThrottling& Delegate)
+		{
+			return Delegate.GetHandle() == CPUThrottlingHandle;
+		});
+		CPUThrottlingHandle.Reset();
+	}
+
 	bIsRunning = false;
-	UE_LOG(LogTemp, Display, TEXT("UnrealEditorMCP: HTTP Server stopped"));
+	UE_LOG(LogUnrealEditorMCP, Display, TEXT("UnrealEditorMCP: HTTP Server stopped"));
 }
 
 void FUnrealEditorMCPHttpServer::SetupRoutes()
@@ -113,11 +181,22 @@ void FUnrealEditorMCPHttpServer::SetupRoutes()
 		FHttpRequestHandler::CreateRaw(this, &FUnrealEditorMCPHttpServer::HandleListTools)
 	);
 
-	// POST /mcp/tool/* - Execute a tool (wildcard path)
+	// POST /mcp/tool/{name} - Execute a tool (one route per command; the command and its name are resolved once here)
+	for (const TSharedPtr<IEditorCommand>& Command : CommandRegistry->GetAllCommands())
+	{
+		const FString CommandName = Command->GetName();
+		ToolRouteHandles.Add(HttpRouter->BindRoute(
+			FHttpPath(FString::Printf(TEXT("/mcp/tool/%s"), *CommandName)),
+			EHttpServerRequestVerbs::VERB_POST,
+			FHttpRequestHandler::CreateRaw(this, &FUnrealEditorMCPHttpServer::HandleExecuteTool, Command.ToSharedRef(), FName(*CommandName))
+		));
+	}
+
+	// POST /mcp/tool/* - Fallback for names without a dedicated route (wildcard path)
 	ExecuteToolHandle = HttpRouter->BindRoute(
 		FHttpPath(TEXT("/mcp/tool")),
 		EHttpServerRequestVerbs::VERB_POST,
-		FHttpRequestHandler::CreateRaw(this, &FUnrealEditorMCPHttpServer::HandleExecuteTool)
+		FHttpRequestHandler::CreateRaw(this, &FUnrealEditorMCPHttpServer::HandleUnknownTool)
 	);
 
 	// GET /mcp/status - Server status
@@ -126,19 +205,34 @@ void FUnrealEditorMCPHttpServer::SetupRoutes()
 		EHttpServerRequestVerbs::VERB_GET,
 		FHttpRequestHandler::CreateRaw(this, &FUnrealEditorMCPHttpServer::HandleStatus)
 	);
+
+	// GET /mcp/metrics - Request metrics in Prometheus text format
+	MetricsHandle = HttpRouter->BindRoute(
+		FHttpPath(TEXT("/mcp/metrics")),
+		EHttpServerRequestVerbs::VERB_GET,
+		FHttpRequestHandler::CreateRaw(this, &FUnrealEditorMCPHttpServer::HandleMetrics)
+	);
+
+	// GET /mcp/debug/requests - Recent request summaries (?limit=N)
+	DebugRequestsHandle = HttpRouter->BindRoute(
+		FHttpPath(TEXT("/mcp/debug/requests")),
+		EHttpServerRequestVerbs::VERB_GET,
+		FHttpRequestHandler::CreateRaw(this, &FUnrealEditorMCPHttpServer::HandleDebugRequests)
+	);
 }
 
 bool FUnrealEditorMCPHttpServer::HandleListTools(const FHttpServerRequest& Request,
                                                  const FHttpResultCallback& OnComplete) const
 {
+	FMCPGameThreadTimeScope GameThreadTime(Metrics.Get());
 	FMCPToolsListResponse Response;
-	Response.tools = FMCPJsonHelpers::CommandsToToolInfoArray(CommandRegistry->GetAllCommands(), true);
+	Response.tools = CommandRegistry->GetToolInfos();
 
 	OnComplete(FMCPJsonHelpers::CreateJsonResponse(Response));
 	return true;
 }
 
-bool FUnrealEditorMCPHttpServer::HandleExecuteTool(const FHttpServerRequest& Request,
+bool FUnrealEditorMCPHttpServer::HandleUnknownTool(const FHttpServerRequest& Request,
                                                    const FHttpResultCallback& OnComplete) const
 {
 	// 1. Extract the tool name from a path: /mcp/tool/{name}
@@ -146,7 +240,7 @@ bool FUnrealEditorMCPHttpServer::HandleExecuteTool(const FHttpServerRequest& Req
 	FString CommandName;
 
 	// Debug log to see what path we're receiving
-	UE_LOG(LogTemp, Display, TEXT("UnrealEditorMCP HTTP: Received path: %s"), *RelativePath);
+	UE_LOG(LogUnrealEditorMCP, Verbose, TEXT("UnrealEditorMCP HTTP: Received path: %s"), *RelativePath);
 
 	// Parse tool name from a path (handle different path formats)
 	if (RelativePath.StartsWith(TEXT("/mcp/tool/")))
@@ -164,83 +258,223 @@ bool FUnrealEditorMCPHttpServer::HandleExecuteTool(const FHttpServerRequest& Req
 
 	if (CommandName.IsEmpty())
 	{
-		UE_LOG(LogTemp, Error, TEXT("UnrealEditorMCP HTTP: Tool name is empty from path: %s"), *RelativePath);
+		UE_LOG(LogUnrealEditorMCP, Error, TEXT("UnrealEditorMCP HTTP: Tool name is empty from path: %s"), *RelativePath);
 		OnComplete(FMCPJsonHelpers::CreateErrorResponse(
 			TEXT("Tool name not specified. Use POST /mcp/tool/{toolname}"), EHttpServerResponseCodes::BadRequest));
 		return true;
 	}
 
-	UE_LOG(LogTemp, Display, TEXT("UnrealEditorMCP HTTP: Executing tool: %s"), *CommandName);
+	// 2. Names that only differ in case from a registered command still resolve (FName is case-insensitive)
+	const FName CommandFName(*CommandName, FNAME_Find);
+	if (const TSharedPtr<IEditorCommand> Command = CommandRegistry->GetCommand(CommandFName))
+	{
+		return HandleExecuteTool(Request, OnComplete, Command.ToSharedRef(), CommandFName);
+	}
+
+	UE_LOG(LogUnrealEditorMCP, Error, TEXT("UnrealEditorMCP HTTP: Unknown command: %s"), *CommandName);
+	Metrics->RecordUnknownTool();
+	OnComplete(FMCPJsonHelpers::CreateErrorResponse(
+		FString::Printf(TEXT("Unknown command: %s"), *CommandName),
+		EHttpServerResponseCodes::NotFound));
+	return true;
+}
+
+bool FUnrealEditorMCPHttpServer::HandleExecuteTool(const FHttpServerRequest& Request,
+                                                   const FHttpResultCallback& OnComplete,
+                                                   TSharedRef<IEditorCommand> Command, const FName CommandName) const
+{
+	FMCPGameThreadTimeScope GameThreadTime(Metrics.Get());
+
+	const uint64 RequestId = NextRequestId.fetch_add(1, std::memory_order_relaxed);
+	LastRequestTime.store(FPlatformTime::Seconds(), std::memory_order_relaxed);
+	MCP_TRACE_REQUEST_SCOPE("Request", *Command, RequestId);
+
+	UE_LOG(LogUnrealEditorMCP, Verbose, TEXT("UnrealEditorMCP HTTP: Executing tool: %s (request %llu)"), *Command->GetName(), RequestId);
+
+	FEditorCommandRequest CommandRequest{&Command.Get(), RequestId, nullptr, OnComplete};
+	CommandRequest.CommandName = CommandName;
+	CommandRequest.Timing.ReceivedTime = FPlatformTime::Seconds();
+	CommandRequest.Metrics = Metrics->FindCommandMetrics(&Command.Get());
+	CommandRequest.RequestBytes = Request.Body.Num();
+	CommandRequest.bIncludeTiming = !FMCPJsonHelpers::GetRequestHeader(Request, TEXT("X-MCP-Timing")).IsEmpty();
+	CommandRequest.SessionId = FMCPJsonHelpers::GetRequestHeader(Request, TEXT("X-MCP-Session"));
+
+	// Clients may only lower the command's priority (e.g. run a query as bulk), never raise it
+	CommandRequest.Priority = Command->GetPriority();
+	if (EEditorCommandPriority RequestedPriority;
+		LexTryParseString(RequestedPriority, *FMCPJsonHelpers::GetRequestHeader(Request, TEXT("X-MCP-Priority"))) &&
+		RequestedPriority > CommandRequest.Priority)
+	{
+		CommandRequest.Priority = RequestedPriority;
+	}
+	if (CommandRequest.Metrics)
+	{
+		FMCPMetrics::RecordRequestStarted(*CommandRequest.Metrics, Request.Body.Num());
+	}
+
+	// Requests answered on this thread (errors and cache hits) are recorded here
+	auto CompleteNow = [this, &CommandRequest, &OnComplete](TUniquePtr<FHttpServerResponse> Response)
+	{
+		Response->Headers.Add(TEXT("Server-Timing"), {CommandRequest.Timing.ToServerTimingHeader(FPlatformTime::Seconds())});
+		if (CommandRequest.Metrics)
+		{
+			Metrics->RecordRequestCompleted(*CommandRequest.Metrics, CommandRequest.RequestId, CommandRequest.Timing,
+			                                CommandRequest.RequestBytes, *Response,
+			                                Response->Code != EHttpServerResponseCodes::Ok);
+		}
+		OnComplete(MoveTemp(Response));
+	};
 
-	// 2. Parse JSON body
+	// 1. Parse JSON body (converted straight from the request bytes, no null-terminated copy)
 	TSharedPtr<FJsonObject> ParamsJson = MakeShared<FJsonObject>();
 	if (Request.Body.Num() > 0)
 	{
-		TArray<uint8> NullTerminatedBody = Request.Body;
-		NullTerminatedBody.Add(0);
-		const FString BodyString = UTF8_TO_TCHAR(reinterpret_cast<const char*>(NullTerminatedBody.GetData()));
+		MCP_TRACE_REQUEST_SCOPE("Parse", *Command, RequestId);
+		const FUTF8ToTCHAR BodyConverter(reinterpret_cast<const ANSICHAR*>(Request.Body.GetData()), Request.Body.Num());
+		const FStringView BodyView(BodyConverter.Get(), BodyConverter.Length());
 
-		if (TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(BodyString); !FJsonSerializer::Deserialize(Reader, ParamsJson))
+		if (TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::CreateFromView(BodyView); !FJsonSerializer::Deserialize(Reader, ParamsJson))
 		{
-			UE_LOG(LogTemp, Error, TEXT("UnrealEditorMCP HTTP: Failed to parse JSON body: %s"), *BodyString);
-			OnComplete(FMCPJsonHelpers::CreateErrorResponse(TEXT("Invalid JSON body"), EHttpServerResponseCodes::BadRequest));
+			// The body itself is only logged at VeryVerbose; it can be arbitrarily large
+			UE_LOG(LogUnrealEditorMCP, Warning, TEXT("UnrealEditorMCP HTTP: Failed to parse JSON body of request %llu (%d bytes)"),
+			       RequestId, Request.Body.Num());
+			UE_LOG(LogUnrealEditorMCP, VeryVerbose, TEXT("UnrealEditorMCP HTTP: Request %llu body: %s"), RequestId, *FString(BodyView));
+			CompleteNow(FMCPJsonHelpers::CreateErrorResponse(TEXT("Invalid JSON body"), EHttpServerResponseCodes::BadRequest));
 			return true;
 		}
 	}
 
-	// 3. Check if the command exists
-	if (!CommandRegistry->HasCommand(CommandName))
+	// 2. Decode and validate typed params here, so bad requests never reach the game thread
+	CommandRequest.Params = ParamsJson;
+	if (Command->GetParamsStruct())
 	{
-		UE_LOG(LogTemp, Error, TEXT("UnrealEditorMCP HTTP: Unknown command: %s"), *CommandName);
-		OnComplete(FMCPJsonHelpers::CreateErrorResponse(
-			FString::Printf(TEXT("Unknown command: %s"), *CommandName),
-			EHttpServerResponseCodes::NotFound));
-		return true;
+		if (FString Error; !Command->DecodeParams(ParamsJson, CommandRequest.TypedParams, Error))
+		{
+			CompleteNow(FMCPJsonHelpers::CreateErrorResponse(Error, EHttpServerResponseCodes::BadRequest));
+			return true;
+		}
+	}
+
+	CommandRequest.Timing.ParsedTime = FPlatformTime::Seconds();
+
+	// 3. Serve cacheable commands from the result cache if nothing changed since the last call
+	//    (responses with a _timing block are always executed, so the block reflects a real run).
+	//    While a write is in flight the cached body may predate it, so the read waits for the write.
+	if (Command->IsCacheable() && !CommandRequest.bIncludeTiming)
+	{
+		FEditorCommandResultCache& ResultCache = CommandRegistry->GetResultCache().Get();
+		CommandRequest.CacheRevision = ResultCache.GetRevision();
+		CommandRequest.CacheKey = FEditorCommandResultCache::MakeKey(Command->GetName(), ParamsJson);
+
+		if (TArray<uint8> CachedBody;
+			!CommandScheduler->HasPendingWrites() && ResultCache.Find(CommandRequest.CacheKey, CachedBody))
+		{
+			CompleteNow(FMCPJsonHelpers::CreateRawJsonResponse(MoveTemp(CachedBody)));
+			return true;
+		}
 	}
 
-	// 4. Execute command on GameThread asynchronously
-	AsyncTask(ENamedThreads::GameThread,
-	          [this, CommandName, ParamsJson, OnComplete]()
-	          {
-		          // Get command from registry
-		          TSharedPtr<IEditorCommand> Command = CommandRegistry->GetCommand(CommandName);
-		          if (!Command.IsValid())
-		          {
-			          FMCPCommandResponse ErrorResponse;
-			          ErrorResponse.success = false;
-			          ErrorResponse.error = TEXT("Command not found in registry");
-			          OnComplete(FMCPJsonHelpers::CreateJsonResponse(ErrorResponse));
-			          return;
-		          }
-
-		          // Execute command (returns FJsonObjectWrapper directly)
-		          FJsonObjectWrapper ResultWrapper = Command->Execute(ParamsJson);
-
-		          // Build response
-		          FMCPCommandResponse Response;
-		          Response.success = true;
-		          Response.message = TEXT("Command executed successfully");
-		          Response.data = ResultWrapper;
-
-		          // Call the completion callback
-		          OnComplete(FMCPJsonHelpers::CreateJsonResponse(Response));
-	          });
+	// 4. Answer reads from the world snapshot on a worker when it reflects every completed edit
+	//    (no write in flight, no change waiting to be published)
+	if (!CommandScheduler->HasPendingWrites() && !WorldSnapshot->HasPendingChanges())
+	{
+		const FEditorCommandInvocation Invocation{ParamsJson, CommandRequest.TypedParams.IsValid() ? &CommandRequest.TypedParams : nullptr};
+		if (const TSharedPtr<const FMCPWorldSnapshot> Snapshot = WorldSnapshot->GetLatest();
+			Snapshot.IsValid() && Command->CanExecuteOnSnapshot(*Snapshot, Invocation))
+		{
+			CommandScheduler->ExecuteOnSnapshot(MoveTemp(CommandRequest), Command, Snapshot.ToSharedRef());
+			return true;
+		}
+	}
+
+	// 5. Queue the resolved command for execution on the GameThread
+	{
+		MCP_TRACE_REQUEST_SCOPE("Enqueue", *Command, RequestId);
+		CommandScheduler->Enqueue(MoveTemp(CommandRequest));
+	}
 
 	return true;
 }
 
 bool FUnrealEditorMCPHttpServer::HandleStatus(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete) const
 {
+	FMCPGameThreadTimeScope GameThreadTime(Metrics.Get());
 	FMCPStatusResponse Response;
 	Response.status = TEXT("running");
 	Response.httpPort = ServerPort;
 	Response.socketPort = 55557;
 	Response.version = TEXT("1.0.0");
 	Response.toolCount = CommandRegistry->GetCommandCount();
-	Response.tools = FMCPJsonHelpers::CommandsToToolInfoArray(CommandRegistry->GetAllCommands(), false);
+	Response.tools = FMCPJsonHelpers::StripParameters(CommandRegistry->GetToolInfos());
 	Response.projectName = FApp::GetProjectName();
 	Response.engineVersion = FEngineVersion::Current().ToString();
 
+	Response.tickRate = CommandScheduler->GetTickRate();
+	Response.cpuThrottlingSuspended = ShouldDisableCPUThrottling();
+	Response.pythonJobs = PythonJobs->Num();
+
+	if (const TSharedPtr<const FMCPWorldSnapshot> Snapshot = WorldSnapshot->GetLatest())
+	{
+		Response.snapshotRevision = static_cast<int64>(Snapshot->Revision);
+		Response.snapshotActorCount = Snapshot->Actors.Num();
+	}
+
+	OnComplete(FMCPJsonHelpers::CreateJsonResponse(Response));
+	return true;
+}
+
+bool FUnrealEditorMCPHttpServer::ShouldDisableCPUThrottling() const
+{
+	// Pending work, or a client that sent a request recently and is likely to send the next one soon
+	const double SecondsSinceLastRequest = FPlatformTime::Seconds() - LastRequestTime.load(std::memory_order_relaxed);
+	return CommandScheduler->HasPendingWork() || SecondsSinceLastRequest < CVarMCPKeepAwakeSeconds.GetValueOnGameThread();
+}
+
+bool FUnrealEditorMCPHttpServer::HandleMetrics(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete) const
+{
+	FMCPGameThreadTimeScope GameThreadTime(Metrics.Get());
+	TUniquePtr<FHttpServerResponse> Response = FHttpServerResponse::Create(
+		Metrics->RenderPrometheusText(), TEXT("text/plain; version=0.0.4; charset=utf-8"));
+	FMCPJsonHelpers::AddCorsHeaders(*Response);
+
+	OnComplete(MoveTemp(Response));
+	return true;
+}
+
+bool FUnrealEditorMCPHttpServer::HandleDebugRequests(const FHttpServerRequest& Request,
+                                                     const FHttpResultCallback& OnComplete) const
+{
+	FMCPGameThreadTimeScope GameThreadTime(Metrics.Get());
+	int32 Limit = FMCPRequestLog::Capacity;
+	if (const FString* LimitParam = Request.QueryParams.Find(TEXT("limit")))
+	{
+		Limit = FCString::Atoi(**LimitParam);
+	}
+
+	const FMCPRequestLog& RequestLog = Metrics->GetRequestLog();
+
+	FMCPDebugRequestsResponse Response;
+	Response.totalRecorded = static_cast<int64>(RequestLog.GetTotalRecorded());
+	Response.sampleEvery = FMCPRequestLog::GetSampleEvery();
+
+	for (const FMCPRequestRecord& Record : RequestLog.GetRecent(Limit))
+	{
+		FMCPRequestLogEntry& Entry = Response.requests.AddDefaulted_GetRef();
+		Entry.id = static_cast<int64>(Record.RequestId);
+		Entry.command = Record.Command ? Record.Command->CommandName : FString();
+		Entry.status = Record.StatusCode;
+		Entry.error = Record.bError;
+		Entry.requestBytes = Record.RequestBytes;
+		Entry.responseBytes = Record.ResponseBytes;
+		Entry.completedAt = FDateTime(Record.CompletedTicks).ToIso8601();
+		Entry.parseMs = Record.ParseMs;
+		Entry.queueMs = Record.QueueMs;
+		Entry.gameThreadWaitMs = Record.GameThreadWaitMs;
+		Entry.executeMs = Record.ExecuteMs;
+		Entry.serializeMs = Record.SerializeMs;
+		Entry.totalMs = Record.TotalMs;
+	}
+
 	OnComplete(FMCPJsonHelpers::CreateJsonResponse(Response));
 	return true;
 }
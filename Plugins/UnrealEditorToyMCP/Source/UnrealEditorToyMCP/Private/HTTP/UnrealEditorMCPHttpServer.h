@@ -4,13 +4,19 @@
 
 #include "CoreMinimal.h"
 #include "IHttpRouter.h"
+#include <atomic>
 
 class FEditorCommandRegistry;
+class IEditorCommand;
+class FEditorCommandScheduler;
+class FMCPMetrics;
+class FMCPPythonJobRegistry;
+class FMCPWorldSnapshotBuilder;
 
 class FUnrealEditorMCPHttpServer
 {
 public:
-	FUnrealEditorMCPHttpServer();
+	explicit FUnrealEditorMCPHttpServer(const TSharedRef<FMCPWorldSnapshotBuilder>& InWorldSnapshot);
 	~FUnrealEditorMCPHttpServer();
 
 	// Server lifecycle
@@ -25,18 +31,49 @@ private:
 
 	// Endpoint handlers
 	bool HandleListTools(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete) const;
-	bool HandleExecuteTool(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete) const;
+	bool HandleExecuteTool(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete, TSharedRef<IEditorCommand> Command,
+	                       FName CommandName) const;
+	bool HandleUnknownTool(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete) const;
 	bool HandleStatus(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete) const;
+	bool HandleMetrics(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete) const;
+	bool HandleDebugRequests(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete) const;
+
+	// Editor background throttling (UEditorEngine::ShouldDisableCPUThrottlingDelegates)
+	bool ShouldDisableCPUThrottling() const;
 
 	// HTTP infrastructure
 	TSharedPtr<IHttpRouter> HttpRouter;
 	FHttpRouteHandle ListToolsHandle;
 	FHttpRouteHandle ExecuteToolHandle;
+	TArray<FHttpRouteHandle> ToolRouteHandles;
 	FHttpRouteHandle StatusHandle;
+	FHttpRouteHandle MetricsHandle;
+	FHttpRouteHandle DebugRequestsHandle;
 
 	// Command registry
 	TUniquePtr<FEditorCommandRegistry> CommandRegistry;
 
+	// Request metrics (shared with the scheduler and its worker tasks)
+	TSharedPtr<FMCPMetrics> Metrics;
+
+	// World snapshot (answers read-only queries off the game thread)
+	TSharedRef<FMCPWorldSnapshotBuilder> WorldSnapshot;
+
+	// Python jobs in progress (shared by execute_python and python_job)
+	TSharedRef<FMCPPythonJobRegistry> PythonJobs;
+
+	// Command scheduler (game thread execution)
+	TUniquePtr<FEditorCommandScheduler> CommandScheduler;
+
+	// Request id source (handlers are const and may run concurrently)
+	mutable std::atomic<uint64> NextRequestId{1};
+
+	// Arrival time of the latest tool request (FPlatformTime::Seconds), keeps the editor awake for a while
+	mutable std::atomic<double> LastRequestTime{0.0};
+
+	// Registration of ShouldDisableCPUThrottling with the editor
+	FDelegateHandle CPUThrottlingHandle;
+
 	// Server state
 	bool bIsRunning;
 	uint32 ServerPort;
@@ -10,6 +10,57 @@ TUniquePtr<FHttpServerResponse> FMCPJsonHelpers::CreateErrorResponse(
 	return CreateJsonResponse(ErrorResponse, Code);
 }
 
+TUniquePtr<FHttpServerResponse> FMCPJsonHelpers::CreateRawJsonResponse(
+	TArray<uint8>&& JsonBody,
+	const EHttpServerResponseCodes Code)
+{
+	TUniquePtr<FHttpServerResponse> Response = FHttpServerResponse::Create(MoveTemp(JsonBody), TEXT("application/json"));
+	Response->Code = Code;
+	AddCorsHeaders(*Response);
+
+	return Response;
+}
+
+TUniquePtr<FHttpServerResponse> FMCPJsonHelpers::CreateJsonObjectResponse(
+	const TSharedRef<FJsonObject>& JsonObject,
+	const EHttpServerResponseCodes Code)
+{
+	FString JsonString;
+	const TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer =
+		TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&JsonString);
+	if (!FJsonSerializer::Serialize(JsonObject, Writer))
+	{
+		UE_LOG(LogUnrealEditorMCP, Error, TEXT("Failed to serialize JSON object"));
+		return CreateErrorResponse(TEXT("Internal server error"), EHttpServerResponseCodes::ServerError);
+	}
+
+	TUniquePtr<FHttpServerResponse> Response = FHttpServerResponse::Create(JsonString, TEXT("application/json"));
+	Response->Code = Code;
+	AddCorsHeaders(*Response);
+
+	return Response;
+}
+
+FString FMCPJsonHelpers::GetRequestHeader(const FHttpServerRequest& Request, const FString& HeaderName)
+{
+	for (const TPair<FString, TArray<FString>>& Header : Request.Headers)
+	{
+		if (Header.Key.Equals(HeaderName, ESearchCase::IgnoreCase) && Header.Value.Num() > 0)
+		{
+			return Header.Value[0];
+		}
+	}
+	return FString();
+}
+
+void FMCPJsonHelpers::AddCorsHeaders(FHttpServerResponse& Response)
+{
+	Response.Headers.Add(TEXT("Access-Control-Allow-Origin"), {TEXT("http://localhost")});
+	Response.Headers.Add(TEXT("Access-Control-Allow-Methods"), {TEXT("GET, POST, OPTIONS")});
+	Response.Headers.Add(TEXT("Access-Control-Allow-Headers"), {TEXT("Content-Type, X-MCP-Timing, X-MCP-Session, X-MCP-Priority")});
+	Response.Headers.Add(TEXT("Access-Control-Expose-Headers"), {TEXT("Server-Timing")});
+}
+
 FMCPToolInfo FMCPJsonHelpers::CommandToToolInfo(const TSharedPtr<IEditorCommand>& Command, bool bIncludeParameters)
 {
 	FMCPToolInfo ToolInfo;
@@ -53,3 +104,18 @@ TArray<FMCPToolInfo> FMCPJsonHelpers::CommandsToToolInfoArray(const TArray<TShar
 
 	return ToolInfoArray;
 }
+
+TArray<FMCPToolInfo> FMCPJsonHelpers::StripParameters(const TArray<FMCPToolInfo>& ToolInfos)
+{
+	TArray<FMCPToolInfo> ToolInfoArray;
+	ToolInfoArray.Reserve(ToolInfos.Num());
+
+	for (const FMCPToolInfo& ToolInfo : ToolInfos)
+	{
+		FMCPToolInfo& Stripped = ToolInfoArray.AddDefaulted_GetRef();
+		Stripped.name = ToolInfo.name;
+		Stripped.description = ToolInfo.description;
+	}
+
+	return ToolInfoArray;
+}
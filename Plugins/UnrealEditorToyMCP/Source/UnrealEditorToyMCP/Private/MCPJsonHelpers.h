@@ -2,8 +2,10 @@
 
 #include "CoreMinimal.h"
 #include "JsonObjectConverter.h"
+#include "HttpServerRequest.h"
 #include "HttpServerResponse.h"
 #include "MCPJsonStructs.h"
+#include "UnrealEditorMCP.h"
 
 class FMCPJsonHelpers
 {
@@ -29,21 +31,33 @@ public:
 		FString JsonString;
 		if (!StructToJsonString(Struct, JsonString))
 		{
-			UE_LOG(LogTemp, Error, TEXT("Failed to serialize struct to JSON"));
+			UE_LOG(LogUnrealEditorMCP, Error, TEXT("Failed to serialize struct to JSON"));
 			return CreateErrorResponse(TEXT("Internal server error"), EHttpServerResponseCodes::ServerError);
 		}
 
 		TUniquePtr<FHttpServerResponse> Response = FHttpServerResponse::Create(JsonString, TEXT("application/json"));
 		Response->Code = Code;
-
-		// CORS headers
-		Response->Headers.Add(TEXT("Access-Control-Allow-Origin"), {TEXT("http://localhost")});
-		Response->Headers.Add(TEXT("Access-Control-Allow-Methods"), {TEXT("GET, POST, OPTIONS")});
-		Response->Headers.Add(TEXT("Access-Control-Allow-Headers"), {TEXT("Content-Type")});
+		AddCorsHeaders(*Response);
 
 		return Response;
 	}
 
+	// シリアライズ済み JSON (UTF-8) からのレスポンスの作成
+	static TUniquePtr<FHttpServerResponse> CreateRawJsonResponse(
+		TArray<uint8>&& JsonBody,
+		EHttpServerResponseCodes Code = EHttpServerResponseCodes::Ok);
+
+	// JSON オブジェクトからのレスポンスの作成
+	static TUniquePtr<FHttpServerResponse> CreateJsonObjectResponse(
+		const TSharedRef<FJsonObject>& JsonObject,
+		EHttpServerResponseCodes Code = EHttpServerResponseCodes::Ok);
+
+	// リクエストヘッダーの取得 (名前は大文字小文字を区別しない、見つからなければ空文字列)
+	static FString GetRequestHeader(const FHttpServerRequest& Request, const FString& HeaderName);
+
+	// CORS ヘッダーの追加
+	static void AddCorsHeaders(FHttpServerResponse& Response);
+
 	// エラーレスポンスの作成
 	static TUniquePtr<FHttpServerResponse> CreateErrorResponse(
 		const FString& ErrorMessage,
@@ -54,4 +68,7 @@ public:
 
 	// IEditorCommand 配列から FMCPToolInfo 配列への変換
 	static TArray<FMCPToolInfo> CommandsToToolInfoArray(const TArray<TSharedPtr<class IEditorCommand>>& Commands, bool bIncludeParameters = true);
+
+	// FMCPToolInfo 配列からパラメータを除いたコピーを作成
+	static TArray<FMCPToolInfo> StripParameters(const TArray<FMCPToolInfo>& ToolInfos);
 };
@@ -0,0 +1,284 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "MCPMetrics.h"
+#include "Commands/IEditorCommand.h"
+#include "HttpServerResponse.h"
+
+namespace
+{
+	uint64 ToMicroseconds(const double Seconds)
+	{
+		return static_cast<uint64>(FMath::Max(Seconds, 0.0) * 1000000.0);
+	}
+
+	void AppendHeader(FString& Out, const TCHAR* MetricName, const TCHAR* Type, const TCHAR* Help)
+	{
+		Out += FString::Printf(TEXT("# HELP %s %s\n# TYPE %s %s\n"), MetricName, Help, MetricName, Type);
+	}
+
+	FString CommandLabel(const FMCPCommandMetrics& CommandMetrics)
+	{
+		return FString::Printf(TEXT("command=\"%s\""), *CommandMetrics.CommandName);
+	}
+
+	// Duration of a stage in milliseconds, or a negative value if the stage did not run
+	double GetStageMs(const double Start, const double End)
+	{
+		return Start > 0.0 && End > 0.0 ? FMath::Max(End - Start, 0.0) * 1000.0 : -1.0;
+	}
+
+	// Stage durations in milliseconds, in pipeline order (stages that did not run are skipped)
+	TArray<TPair<const TCHAR*, double>> GetStageDurations(const FMCPRequestTiming& Timing, const double EndTime)
+	{
+		TArray<TPair<const TCHAR*, double>> Stages;
+		auto AddStage = [&Stages](const TCHAR* Name, const double Start, const double End)
+		{
+			if (const double Ms = GetStageMs(Start, End); Ms >= 0.0)
+			{
+				Stages.Emplace(Name, Ms);
+			}
+		};
+
+		AddStage(TEXT("parse"), Timing.ReceivedTime, Timing.ParsedTime);
+		AddStage(TEXT("queue"), Timing.EnqueuedTime, Timing.DequeuedTime);
+		AddStage(TEXT("gtwait"), Timing.DequeuedTime, Timing.ExecuteStartTime);
+		AddStage(TEXT("execute"), Timing.ExecuteStartTime, Timing.ExecuteEndTime);
+		AddStage(TEXT("serialize"), Timing.ExecuteEndTime, Timing.SerializeEndTime);
+		AddStage(TEXT("total"), Timing.ReceivedTime, EndTime);
+		return Stages;
+	}
+}
+
+FString FMCPRequestTiming::ToServerTimingHeader(const double EndTime) const
+{
+	TArray<FString> Entries;
+	for (const TPair<const TCHAR*, double>& Stage : GetStageDurations(*this, EndTime))
+	{
+		Entries.Add(FString::Printf(TEXT("%s;dur=%.3f"), Stage.Key, Stage.Value));
+	}
+	return FString::Join(Entries, TEXT(", "));
+}
+
+TSharedRef<FJsonObject> FMCPRequestTiming::ToJsonObject(const double EndTime) const
+{
+	TSharedRef<FJsonObject> TimingObject = MakeShared<FJsonObject>();
+	for (const TPair<const TCHAR*, double>& Stage : GetStageDurations(*this, EndTime))
+	{
+		TimingObject->SetNumberField(FString::Printf(TEXT("%s_ms"), Stage.Key), Stage.Value);
+	}
+	return TimingObject;
+}
+
+const double FMCPLatencyHistogram::BucketBounds[NumBuckets] = {
+	0.0005, 0.001, 0.0025, 0.005, 0.01, 0.025, 0.05, 0.1, 0.25, 0.5, 1.0, 2.5, 5.0, 10.0
+};
+
+void FMCPLatencyHistogram::Record(const double Seconds)
+{
+	int32 Bucket = 0;
+	while (Bucket < NumBuckets && Seconds > BucketBounds[Bucket])
+	{
+		++Bucket;
+	}
+
+	BucketCounts[Bucket].fetch_add(1, std::memory_order_relaxed);
+	SumMicroseconds.fetch_add(ToMicroseconds(Seconds), std::memory_order_relaxed);
+	Count.fetch_add(1, std::memory_order_relaxed);
+}
+
+void FMCPLatencyHistogram::Render(FString& Out, const TCHAR* MetricName, const FString& Labels) const
+{
+	const FString LabelPrefix = Labels.IsEmpty() ? FString() : Labels + TEXT(",");
+
+	// Buckets are stored per interval and rendered cumulatively
+	uint64 Cumulative = 0;
+	for (int32 Bucket = 0; Bucket < NumBuckets; ++Bucket)
+	{
+		Cumulative += BucketCounts[Bucket].load(std::memory_order_relaxed);
+		Out += FString::Printf(TEXT("%s_bucket{%sle=\"%s\"} %llu\n"),
+		                       MetricName, *LabelPrefix, *FString::SanitizeFloat(BucketBounds[Bucket]), Cumulative);
+	}
+	Cumulative += BucketCounts[NumBuckets].load(std::memory_order_relaxed);
+	Out += FString::Printf(TEXT("%s_bucket{%sle=\"+Inf\"} %llu\n"), MetricName, *LabelPrefix, Cumulative);
+
+	const FString Braced = Labels.IsEmpty() ? FString() : FString::Printf(TEXT("{%s}"), *Labels);
+	Out += FString::Printf(TEXT("%s_sum%s %.6f\n"), MetricName, *Braced,
+	                       SumMicroseconds.load(std::memory_order_relaxed) / 1000000.0);
+	Out += FString::Printf(TEXT("%s_count%s %llu\n"), MetricName, *Braced, Count.load(std::memory_order_relaxed));
+}
+
+FMCPMetrics::FMCPMetrics(const TArray<TSharedPtr<IEditorCommand>>& Commands)
+{
+	OrderedCommandMetrics.Reserve(Commands.Num());
+	for (const TSharedPtr<IEditorCommand>& Command : Commands)
+	{
+		if (!Command.IsValid())
+		{
+			continue;
+		}
+
+		TUniquePtr<FMCPCommandMetrics>& Slot = CommandMetrics.Add(Command.Get(), MakeUnique<FMCPCommandMetrics>());
+		Slot->CommandName = Command->GetName();
+		OrderedCommandMetrics.Add(Slot.Get());
+	}
+}
+
+FMCPCommandMetrics* FMCPMetrics::FindCommandMetrics(const IEditorCommand* Command) const
+{
+	// The map is only written in the constructor, so concurrent lookups are safe
+	const TUniquePtr<FMCPCommandMetrics>* Slot = CommandMetrics.Find(Command);
+	return Slot ? Slot->Get() : nullptr;
+}
+
+void FMCPMetrics::RecordRequestStarted(FMCPCommandMetrics& CommandMetrics, const int32 RequestBytes)
+{
+	CommandMetrics.Requests.fetch_add(1, std::memory_order_relaxed);
+	CommandMetrics.InFlight.fetch_add(1, std::memory_order_relaxed);
+	CommandMetrics.RequestBytes.fetch_add(RequestBytes, std::memory_order_relaxed);
+}
+
+void FMCPMetrics::RecordRequestCompleted(FMCPCommandMetrics& CommandMetrics, const uint64 RequestId,
+                                         const FMCPRequestTiming& Timing, const int32 RequestBytes,
+                                         const FHttpServerResponse& Response, const bool bError)
+{
+	const double Now = FPlatformTime::Seconds();
+	const int32 ResponseBytes = Response.Body.Num();
+
+	if (Timing.EnqueuedTime > 0.0 && Timing.ExecuteStartTime > 0.0)
+	{
+		CommandMetrics.QueueWait.Record(Timing.ExecuteStartTime - Timing.EnqueuedTime);
+	}
+	if (Timing.ExecuteStartTime > 0.0 && Timing.ExecuteEndTime > 0.0)
+	{
+		CommandMetrics.Execute.Record(Timing.ExecuteEndTime - Timing.ExecuteStartTime);
+	}
+	if (Timing.ExecuteEndTime > 0.0 && Timing.SerializeEndTime > 0.0)
+	{
+		CommandMetrics.Serialize.Record(Timing.SerializeEndTime - Timing.ExecuteEndTime);
+	}
+	CommandMetrics.Total.Record(Now - Timing.ReceivedTime);
+
+	CommandMetrics.ResponseBytes.fetch_add(ResponseBytes, std::memory_order_relaxed);
+	if (bError)
+	{
+		CommandMetrics.Errors.fetch_add(1, std::memory_order_relaxed);
+	}
+	CommandMetrics.InFlight.fetch_sub(1, std::memory_order_relaxed);
+
+	if (FMCPRequestLog::ShouldRecord(RequestId, bError))
+	{
+		FMCPRequestRecord Record;
+		Record.RequestId = RequestId;
+		Record.Command = &CommandMetrics;
+		Record.StatusCode = static_cast<int32>(Response.Code);
+		Record.bError = bError;
+		Record.RequestBytes = RequestBytes;
+		Record.ResponseBytes = ResponseBytes;
+		Record.CompletedTicks = FDateTime::UtcNow().GetTicks();
+		Record.ParseMs = GetStageMs(Timing.ReceivedTime, Timing.ParsedTime);
+		Record.QueueMs = GetStageMs(Timing.EnqueuedTime, Timing.DequeuedTime);
+		Record.GameThreadWaitMs = GetStageMs(Timing.DequeuedTime, Timing.ExecuteStartTime);
+		Record.ExecuteMs = GetStageMs(Timing.ExecuteStartTime, Timing.ExecuteEndTime);
+		Record.SerializeMs = GetStageMs(Timing.ExecuteEndTime, Timing.SerializeEndTime);
+		Record.TotalMs = GetStageMs(Timing.ReceivedTime, Now);
+		RequestLog.Add(Record);
+	}
+}
+
+void FMCPMetrics::RecordTimeout(FMCPCommandMetrics& CommandMetrics)
+{
+	CommandMetrics.Timeouts.fetch_add(1, std::memory_order_relaxed);
+}
+
+void FMCPMetrics::AddGameThreadTime(const double Seconds)
+{
+	check(IsInGameThread());
+
+	// A new frame closes the previous one's total
+	if (GFrameCounter != CurrentFrame)
+	{
+		if (CurrentFrameSeconds > 0.0)
+		{
+			GameThreadPerFrame.Record(CurrentFrameSeconds);
+		}
+		CurrentFrame = GFrameCounter;
+		CurrentFrameSeconds = 0.0;
+	}
+
+	CurrentFrameSeconds += Seconds;
+	GameThreadMicroseconds.fetch_add(ToMicroseconds(Seconds), std::memory_order_relaxed);
+}
+
+FString FMCPMetrics::RenderPrometheusText() const
+{
+	FString Out;
+
+	// 1. Per-command counters and gauges
+	AppendHeader(Out, TEXT("mcp_requests_total"), TEXT("counter"), TEXT("Tool requests received."));
+	for (const FMCPCommandMetrics* Metrics : OrderedCommandMetrics)
+	{
+		Out += FString::Printf(TEXT("mcp_requests_total{%s} %llu\n"), *CommandLabel(*Metrics),
+		                       Metrics->Requests.load(std::memory_order_relaxed));
+	}
+
+	AppendHeader(Out, TEXT("mcp_errors_total"), TEXT("counter"), TEXT("Tool requests that failed (HTTP or command error)."));
+	for (const FMCPCommandMetrics* Metrics : OrderedCommandMetrics)
+	{
+		Out += FString::Printf(TEXT("mcp_errors_total{%s} %llu\n"), *CommandLabel(*Metrics),
+		                       Metrics->Errors.load(std::memory_order_relaxed));
+	}
+
+	AppendHeader(Out, TEXT("mcp_timeouts_total"), TEXT("counter"), TEXT("Tool requests aborted by a command timeout."));
+	for (const FMCPCommandMetrics* Metrics : OrderedCommandMetrics)
+	{
+		Out += FString::Printf(TEXT("mcp_timeouts_total{%s} %llu\n"), *CommandLabel(*Metrics),
+		                       Metrics->Timeouts.load(std::memory_order_relaxed));
+	}
+
+	AppendHeader(Out, TEXT("mcp_in_flight_requests"), TEXT("gauge"), TEXT("Tool requests received but not yet answered."));
+	for (const FMCPCommandMetrics* Metrics : OrderedCommandMetrics)
+	{
+		Out += FString::Printf(TEXT("mcp_in_flight_requests{%s} %lld\n"), *CommandLabel(*Metrics),
+		                       Metrics->InFlight.load(std::memory_order_relaxed));
+	}
+
+	AppendHeader(Out, TEXT("mcp_request_bytes_total"), TEXT("counter"), TEXT("Request body bytes received."));
+	for (const FMCPCommandMetrics* Metrics : OrderedCommandMetrics)
+	{
+		Out += FString::Printf(TEXT("mcp_request_bytes_total{%s} %llu\n"), *CommandLabel(*Metrics),
+		                       Metrics->RequestBytes.load(std::memory_order_relaxed));
+	}
+
+	AppendHeader(Out, TEXT("mcp_response_bytes_total"), TEXT("counter"), TEXT("Response body bytes sent."));
+	for (const FMCPCommandMetrics* Metrics : OrderedCommandMetrics)
+	{
+		Out += FString::Printf(TEXT("mcp_response_bytes_total{%s} %llu\n"), *CommandLabel(*Metrics),
+		                       Metrics->ResponseBytes.load(std::memory_order_relaxed));
+	}
+
+	// 2. Per-command latency histograms, one series per pipeline stage
+	AppendHeader(Out, TEXT("mcp_request_duration_seconds"), TEXT("histogram"),
+	             TEXT("Tool request latency by stage (queue_wait, execute, serialize, total)."));
+	for (const FMCPCommandMetrics* Metrics : OrderedCommandMetrics)
+	{
+		const FString Label = CommandLabel(*Metrics);
+		Metrics->QueueWait.Render(Out, TEXT("mcp_request_duration_seconds"), Label + TEXT(",stage=\"queue_wait\""));
+		Metrics->Execute.Render(Out, TEXT("mcp_request_duration_seconds"), Label + TEXT(",stage=\"execute\""));
+		Metrics->Serialize.Render(Out, TEXT("mcp_request_duration_seconds"), Label + TEXT(",stage=\"serialize\""));
+		Metrics->Total.Render(Out, TEXT("mcp_request_duration_seconds"), Label + TEXT(",stage=\"total\""));
+	}
+
+	// 3. Server-wide metrics
+	AppendHeader(Out, TEXT("mcp_unknown_tool_requests_total"), TEXT("counter"), TEXT("Requests for tools that are not registered."));
+	Out += FString::Printf(TEXT("mcp_unknown_tool_requests_total %llu\n"), UnknownToolRequests.load(std::memory_order_relaxed));
+
+	AppendHeader(Out, TEXT("mcp_game_thread_seconds_total"), TEXT("counter"), TEXT("Game thread time spent by MCP (commands, snapshot refreshes, request handling)."));
+	Out += FString::Printf(TEXT("mcp_game_thread_seconds_total %.6f\n"),
+	                       GameThreadMicroseconds.load(std::memory_order_relaxed) / 1000000.0);
+
+	AppendHeader(Out, TEXT("mcp_game_thread_frame_seconds"), TEXT("histogram"),
+	             TEXT("Game thread time spent by MCP per frame (frames with work only)."));
+	GameThreadPerFrame.Render(Out, TEXT("mcp_game_thread_frame_seconds"), FString());
+
+	return Out;
+}
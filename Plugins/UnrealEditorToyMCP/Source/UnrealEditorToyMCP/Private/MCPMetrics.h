@@ -0,0 +1,204 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+#include "MCPRequestLog.h"
+#include <atomic>
+
+class IEditorCommand;
+struct FHttpServerResponse;
+
+/**
+ * Stage timestamps of one request (FPlatformTime::Seconds, 0 if the stage did not run)
+ */
+struct FMCPRequestTiming
+{
+	double ReceivedTime = 0.0;
+	double ParsedTime = 0.0;
+	double EnqueuedTime = 0.0;
+	double DequeuedTime = 0.0;
+	double ExecuteStartTime = 0.0;
+	double ExecuteEndTime = 0.0;
+	double SerializeEndTime = 0.0;
+
+	/**
+	 * Format the stage durations as a Server-Timing header value
+	 * Stages: parse, queue, gtwait (drained but waiting for earlier commands), execute, serialize, total
+	 * @param EndTime End of the request (total is measured up to here)
+	 * @return Header value, e.g. "parse;dur=0.05, queue;dur=8.31, ..., total;dur=9.12" (milliseconds)
+	 */
+	FString ToServerTimingHeader(double EndTime) const;
+
+	/**
+	 * Build the _timing block of a command response
+	 * @param EndTime End of the request (total is measured up to here)
+	 * @return JSON object with <stage>_ms fields
+	 */
+	TSharedRef<FJsonObject> ToJsonObject(double EndTime) const;
+};
+
+/**
+ * Lock-free latency histogram with fixed buckets
+ */
+class FMCPLatencyHistogram
+{
+public:
+	static constexpr int32 NumBuckets = 14;
+
+	// Upper bounds of the buckets in seconds, followed by an implicit +Inf bucket
+	static const double BucketBounds[NumBuckets];
+
+	/**
+	 * Add one observation
+	 * @param Seconds Observed latency
+	 */
+	void Record(double Seconds);
+
+	/**
+	 * Append the histogram in Prometheus text format
+	 * @param Out Text to append to
+	 * @param MetricName Metric name without the _bucket/_sum/_count suffix
+	 * @param Labels Labels shared by every series, without braces (may be empty)
+	 */
+	void Render(FString& Out, const TCHAR* MetricName, const FString& Labels) const;
+
+private:
+	std::atomic<uint64> BucketCounts[NumBuckets + 1] = {};
+	std::atomic<uint64> Count{0};
+	std::atomic<uint64> SumMicroseconds{0};
+};
+
+/**
+ * Counters and histograms of one command
+ */
+struct FMCPCommandMetrics
+{
+	FString CommandName;
+
+	std::atomic<uint64> Requests{0};
+	std::atomic<uint64> Errors{0};
+	std::atomic<uint64> Timeouts{0};
+	std::atomic<int64> InFlight{0};
+	std::atomic<uint64> RequestBytes{0};
+	std::atomic<uint64> ResponseBytes{0};
+
+	FMCPLatencyHistogram QueueWait;
+	FMCPLatencyHistogram Execute;
+	FMCPLatencyHistogram Serialize;
+	FMCPLatencyHistogram Total;
+};
+
+/**
+ * Metrics registry for the MCP request pipeline
+ * Per-command slots are created once at startup; afterwards recording only touches atomics,
+ * so it can be called from the HTTP thread, the game thread and workers without locking.
+ * Rendered in Prometheus text format by GET /mcp/metrics.
+ */
+class FMCPMetrics
+{
+public:
+	/**
+	 * Create metric slots for every command
+	 * @param Commands All registered commands
+	 */
+	explicit FMCPMetrics(const TArray<TSharedPtr<IEditorCommand>>& Commands);
+
+	/**
+	 * Get the metric slot of a command
+	 * @param Command Registered command
+	 * @return Metrics of the command, or nullptr if it was not registered at startup
+	 */
+	FMCPCommandMetrics* FindCommandMetrics(const IEditorCommand* Command) const;
+
+	/**
+	 * Record the start of a request (call once per request on arrival)
+	 * @param CommandMetrics Metrics of the requested command
+	 * @param RequestBytes Size of the request body
+	 */
+	static void RecordRequestStarted(FMCPCommandMetrics& CommandMetrics, int32 RequestBytes);
+
+	/**
+	 * Record the end of a request and add it to the request log (if sampled)
+	 * Stages that did not run (zero timestamps) are not recorded.
+	 * @param CommandMetrics Metrics of the requested command
+	 * @param RequestId Id of the request
+	 * @param Timing Stage timestamps of the request
+	 * @param RequestBytes Size of the request body
+	 * @param Response Response sent to the client
+	 * @param bError True if the request or the command failed
+	 */
+	void RecordRequestCompleted(FMCPCommandMetrics& CommandMetrics, uint64 RequestId, const FMCPRequestTiming& Timing,
+	                            int32 RequestBytes, const FHttpServerResponse& Response, bool bError);
+
+	/**
+	 * Record a request the command aborted because it ran past its timeout
+	 * @param CommandMetrics Metrics of the requested command
+	 */
+	static void RecordTimeout(FMCPCommandMetrics& CommandMetrics);
+
+	/** Record a request to an unknown tool */
+	void RecordUnknownTool() { UnknownToolRequests.fetch_add(1, std::memory_order_relaxed); }
+
+	/**
+	 * Add game thread time MCP consumed to the current frame
+	 * Command execution, snapshot refreshes and route handlers all add to the same frame total,
+	 * which is recorded once a later frame adds time (frames without MCP work are not recorded).
+	 * Must be called on the game thread
+	 * @param Seconds Time spent by MCP
+	 */
+	void AddGameThreadTime(double Seconds);
+
+	/** Recent request summaries (GET /mcp/debug/requests) */
+	const FMCPRequestLog& GetRequestLog() const { return RequestLog; }
+
+	/**
+	 * Render all metrics in Prometheus text exposition format
+	 * @return Metrics text
+	 */
+	FString RenderPrometheusText() const;
+
+private:
+	TMap<const IEditorCommand*, TUniquePtr<FMCPCommandMetrics>> CommandMetrics;
+	TArray<FMCPCommandMetrics*> OrderedCommandMetrics;
+
+	std::atomic<uint64> UnknownToolRequests{0};
+	std::atomic<uint64> GameThreadMicroseconds{0};
+	FMCPLatencyHistogram GameThreadPerFrame;
+
+	// Frame being summed up (GFrameCounter) and its game thread time so far (game thread only)
+	uint64 CurrentFrame = 0;
+	double CurrentFrameSeconds = 0.0;
+
+	FMCPRequestLog RequestLog;
+};
+
+/**
+ * Adds the time until the end of the scope to the game thread time of the current frame
+ * Does nothing off the game thread or without metrics.
+ */
+class FMCPGameThreadTimeScope
+{
+public:
+	explicit FMCPGameThreadTimeScope(FMCPMetrics* InMetrics)
+		: Metrics(IsInGameThread() ? InMetrics : nullptr)
+		  , StartTime(FPlatformTime::Seconds())
+	{
+	}
+
+	~FMCPGameThreadTimeScope()
+	{
+		if (Metrics)
+		{
+			Metrics->AddGameThreadTime(FPlatformTime::Seconds() - StartTime);
+		}
+	}
+
+	FMCPGameThreadTimeScope(const FMCPGameThreadTimeScope&) = delete;
+	FMCPGameThreadTimeScope& operator=(const FMCPGameThreadTimeScope&) = delete;
+
+private:
+	FMCPMetrics* Metrics;
+	double StartTime;
+};
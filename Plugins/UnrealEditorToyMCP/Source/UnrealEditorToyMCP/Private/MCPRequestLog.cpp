@@ -0,0 +1,67 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "MCPRequestLog.h"
+#include "HAL/IConsoleManager.h"
+
+static TAutoConsoleVariable<int32> CVarMCPRequestLogSampleEvery(
+	TEXT("mcp.RequestLog.SampleEvery"),
+	1,
+	TEXT("Record every Nth MCP request in the debug request log (0 = only errors, 1 = every request)."),
+	ECVF_Default);
+
+bool FMCPRequestLog::ShouldRecord(const uint64 RequestId, const bool bError)
+{
+	if (bError)
+	{
+		return true;
+	}
+
+	const int32 SampleEvery = GetSampleEvery();
+	return SampleEvery > 0 && RequestId % SampleEvery == 0;
+}
+
+int32 FMCPRequestLog::GetSampleEvery()
+{
+	return CVarMCPRequestLogSampleEvery.GetValueOnAnyThread();
+}
+
+void FMCPRequestLog::Add(const FMCPRequestRecord& Record)
+{
+	const uint64 Index = NextIndex.fetch_add(1, std::memory_order_relaxed);
+	FSlot& Slot = Slots[Index % Capacity];
+
+	Slot.Sequence.store(Index * 2 + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+	Slot.Record = Record;
+	Slot.Sequence.store((Index + 1) * 2, std::memory_order_release);
+}
+
+TArray<FMCPRequestRecord> FMCPRequestLog::GetRecent(const int32 MaxCount) const
+{
+	TArray<FMCPRequestRecord> Records;
+
+	const uint64 End = NextIndex.load(std::memory_order_acquire);
+	const uint64 Count = FMath::Min<uint64>(End, FMath::Clamp(MaxCount, 0, Capacity));
+	Records.Reserve(Count);
+
+	for (uint64 Index = End; Index > End - Count; --Index)
+	{
+		const FSlot& Slot = Slots[(Index - 1) % Capacity];
+		const uint64 Expected = Index * 2;
+
+		// Skip slots that are still being written or were already overwritten by a newer record
+		if (Slot.Sequence.load(std::memory_order_acquire) != Expected)
+		{
+			continue;
+		}
+
+		const FMCPRequestRecord Record = Slot.Record;
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if (Slot.Sequence.load(std::memory_order_relaxed) == Expected)
+		{
+			Records.Add(Record);
+		}
+	}
+
+	return Records;
+}
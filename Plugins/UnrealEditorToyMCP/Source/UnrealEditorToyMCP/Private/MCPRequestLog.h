@@ -0,0 +1,87 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include <atomic>
+
+struct FMCPCommandMetrics;
+
+/**
+ * Summary of one completed request (trivially copyable, stored by value in the ring buffer)
+ */
+struct FMCPRequestRecord
+{
+	uint64 RequestId = 0;
+
+	// Metric slot of the command (owned by FMCPMetrics, which owns the log)
+	const FMCPCommandMetrics* Command = nullptr;
+
+	int32 StatusCode = 0;
+	bool bError = false;
+	int32 RequestBytes = 0;
+	int32 ResponseBytes = 0;
+
+	// Completion time (FDateTime::UtcNow ticks)
+	int64 CompletedTicks = 0;
+
+	// Stage durations in milliseconds (negative if the stage did not run)
+	float ParseMs = -1.0f;
+	float QueueMs = -1.0f;
+	float GameThreadWaitMs = -1.0f;
+	float ExecuteMs = -1.0f;
+	float SerializeMs = -1.0f;
+	float TotalMs = -1.0f;
+};
+
+/**
+ * Fixed-size ring buffer of recent request summaries
+ * Writers claim a slot with one atomic increment and publish it with a per-slot sequence
+ * number (seqlock), so recording never blocks. Readers skip slots that are being rewritten.
+ * Served by GET /mcp/debug/requests.
+ */
+class FMCPRequestLog
+{
+public:
+	static constexpr int32 Capacity = 512;
+
+	/**
+	 * Check whether a request should be recorded
+	 * Every mcp.RequestLog.SampleEvery-th request is kept (0 keeps none); errors are always kept.
+	 * @param RequestId Id of the request
+	 * @param bError True if the request failed
+	 * @return True if the request should be added
+	 */
+	static bool ShouldRecord(uint64 RequestId, bool bError);
+
+	/** Current value of mcp.RequestLog.SampleEvery */
+	static int32 GetSampleEvery();
+
+	/**
+	 * Add a record, overwriting the oldest one when full
+	 * Thread-safe and lock-free
+	 * @param Record Summary of the completed request
+	 */
+	void Add(const FMCPRequestRecord& Record);
+
+	/**
+	 * Copy the most recent records
+	 * @param MaxCount Maximum number of records to return
+	 * @return Records, newest first
+	 */
+	TArray<FMCPRequestRecord> GetRecent(int32 MaxCount) const;
+
+	/** Total number of records added since startup */
+	uint64 GetTotalRecorded() const { return NextIndex.load(std::memory_order_relaxed); }
+
+private:
+	struct FSlot
+	{
+		// Odd while the slot is being written, (Index + 1) * 2 once record Index is published
+		std::atomic<uint64> Sequence{0};
+		FMCPRequestRecord Record;
+	};
+
+	FSlot Slots[Capacity];
+	std::atomic<uint64> NextIndex{0};
+};
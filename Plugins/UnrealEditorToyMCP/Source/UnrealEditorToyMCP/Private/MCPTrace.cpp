@@ -0,0 +1,5 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "MCPTrace.h"
+
+UE_TRACE_CHANNEL_DEFINE(MCPChannel)
@@ -0,0 +1,66 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "Trace/Trace.h"
+#include "Commands/IEditorCommand.h"
+
+/**
+ * Unreal Insights instrumentation of the MCP request pipeline
+ * Enable with -trace=cpu,mcp (or "Trace.Enable MCP" at runtime).
+ * Scopes are only emitted when both the CPU and the MCP channels are enabled.
+ */
+UE_TRACE_CHANNEL_EXTERN(MCPChannel)
+
+// Static scope on the MCP channel (for work that is not tied to a single request)
+#define MCP_TRACE_SCOPE(Name) TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL_STR(Name, MCPChannel)
+
+// Scope tagged with a request id and command name, e.g. "MCP Execute: get_actors_in_level #42"
+#define MCP_TRACE_REQUEST_SCOPE(Stage, Command, RequestId) \
+	FMCPTraceRequestScope PREPROCESSOR_JOIN(MCPTraceRequestScope, __LINE__)(TEXT(Stage), Command, RequestId)
+
+/**
+ * CPU profiler scope whose name carries the request id and command name
+ * The name is only formatted while the channels are enabled, so disabled tracing costs one branch.
+ */
+class FMCPTraceRequestScope
+{
+public:
+	FMCPTraceRequestScope(const TCHAR* Stage, const IEditorCommand& Command, const uint64 RequestId)
+	{
+#if CPUPROFILERTRACE_ENABLED
+		bEnabled = UE_TRACE_CHANNELEXPR_IS_ENABLED(MCPChannel) && UE_TRACE_CHANNELEXPR_IS_ENABLED(CpuChannel);
+		if (bEnabled)
+		{
+			FCpuProfilerTrace::OutputBeginDynamicEvent(*FString::Printf(TEXT("MCP %s: %s #%llu"), Stage, *Command.GetName(), RequestId));
+		}
+#endif
+	}
+
+	// For worker thread stages, which only know the command by name
+	FMCPTraceRequestScope(const TCHAR* Stage, const FName CommandName, const uint64 RequestId)
+	{
+#if CPUPROFILERTRACE_ENABLED
+		bEnabled = UE_TRACE_CHANNELEXPR_IS_ENABLED(MCPChannel) && UE_TRACE_CHANNELEXPR_IS_ENABLED(CpuChannel);
+		if (bEnabled)
+		{
+			FCpuProfilerTrace::OutputBeginDynamicEvent(*FString::Printf(TEXT("MCP %s: %s #%llu"), Stage, *CommandName.ToString(), RequestId));
+		}
+#endif
+	}
+
+	~FMCPTraceRequestScope()
+	{
+#if CPUPROFILERTRACE_ENABLED
+		if (bEnabled)
+		{
+			FCpuProfilerTrace::OutputEndEvent();
+		}
+#endif
+	}
+
+private:
+	bool bEnabled = false;
+};
@@ -0,0 +1,381 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "MCPWorldSnapshot.h"
+#include "Components/ActorComponent.h"
+#include "Editor.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GameFramework/Actor.h"
+#include "HAL/IConsoleManager.h"
+#include "MCPMetrics.h"
+#include "MCPTrace.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/ScopeRWLock.h"
+
+static TAutoConsoleVariable<bool> CVarMCPSnapshotEnabled(
+	TEXT("mcp.Snapshot.Enabled"),
+	true,
+	TEXT("Answer read-only MCP queries from the world snapshot on worker threads. When disabled, every query runs on the game thread."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarMCPSnapshotRebuildBudgetMs(
+	TEXT("mcp.Snapshot.RebuildBudgetMs"),
+	2.0f,
+	TEXT("Game thread time per frame for rebuilding the whole MCP world snapshot (after undo, map changes and Blueprint recompiles)."),
+	ECVF_Default);
+
+namespace
+{
+	FMCPVector3 ToMCPVector3(const FVector& Vector)
+	{
+		FMCPVector3 Result;
+		Result.x = Vector.X;
+		Result.y = Vector.Y;
+		Result.z = Vector.Z;
+		return Result;
+	}
+}
+
+int32 FMCPWorldSnapshot::FindClass(const FString& ClassName) const
+{
+	// FNAME_Find: a name that was never created cannot belong to a class in the snapshot
+	const FName Name(*ClassName, FNAME_Find);
+	if (Name.IsNone())
+	{
+		return INDEX_NONE;
+	}
+
+	const int32* Index = ClassName.Contains(TEXT("/")) ? ClassIndexByPathName.Find(Name) : ClassIndexByName.Find(Name);
+	return Index ? *Index : INDEX_NONE;
+}
+
+bool FMCPWorldSnapshot::IsChildOf(int32 ClassIndex, const int32 AncestorIndex) const
+{
+	while (Classes.IsValidIndex(ClassIndex))
+	{
+		if (ClassIndex == AncestorIndex)
+		{
+			return true;
+		}
+		ClassIndex = Classes[ClassIndex].SuperIndex;
+	}
+	return false;
+}
+
+FMCPWorldSnapshotBuilder::FMCPWorldSnapshotBuilder()
+{
+	FEditorDelegates::PostUndoRedo.AddRaw(this, &FMCPWorldSnapshotBuilder::HandlePostUndoRedo);
+	FEditorDelegates::MapChange.AddRaw(this, &FMCPWorldSnapshotBuilder::HandleMapChange);
+	FEditorDelegates::OnMapOpened.AddRaw(this, &FMCPWorldSnapshotBuilder::HandleMapOpened);
+	FWorldDelegates::LevelAddedToWorld.AddRaw(this, &FMCPWorldSnapshotBuilder::HandleLevelChanged);
+	FWorldDelegates::LevelRemovedFromWorld.AddRaw(this, &FMCPWorldSnapshotBuilder::HandleLevelChanged);
+	FCoreUObjectDelegates::OnObjectPropertyChanged.AddRaw(this, &FMCPWorldSnapshotBuilder::HandleObjectPropertyChanged);
+	FCoreUObjectDelegates::OnObjectsReplaced.AddRaw(this, &FMCPWorldSnapshotBuilder::HandleObjectsReplaced);
+	FCoreDelegates::OnActorLabelChanged.AddRaw(this, &FMCPWorldSnapshotBuilder::HandleActorChanged);
+
+	if (GEngine)
+	{
+		GEngine->OnLevelActorAdded().AddRaw(this, &FMCPWorldSnapshotBuilder::HandleActorChanged);
+		GEngine->OnLevelActorDeleted().AddRaw(this, &FMCPWorldSnapshotBuilder::HandleActorChanged);
+		GEngine->OnActorMoved().AddRaw(this, &FMCPWorldSnapshotBuilder::HandleActorChanged);
+		GEngine->OnActorsMoved().AddRaw(this, &FMCPWorldSnapshotBuilder::HandleActorsMoved);
+		GEngine->OnLevelActorFolderChanged().AddRaw(this, &FMCPWorldSnapshotBuilder::HandleActorFolderChanged);
+	}
+
+	TickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+		FTickerDelegate::CreateRaw(this, &FMCPWorldSnapshotBuilder::Tick));
+}
+
+FMCPWorldSnapshotBuilder::~FMCPWorldSnapshotBuilder()
+{
+	FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+
+	FEditorDelegates::PostUndoRedo.RemoveAll(this);
+	FEditorDelegates::MapChange.RemoveAll(this);
+	FEditorDelegates::OnMapOpened.RemoveAll(this);
+	FWorldDelegates::LevelAddedToWorld.RemoveAll(this);
+	FWorldDelegates::LevelRemovedFromWorld.RemoveAll(this);
+	FCoreUObjectDelegates::OnObjectPropertyChanged.RemoveAll(this);
+	FCoreUObjectDelegates::OnObjectsReplaced.RemoveAll(this);
+	FCoreDelegates::OnActorLabelChanged.RemoveAll(this);
+
+	if (GEngine)
+	{
+		GEngine->OnLevelActorAdded().RemoveAll(this);
+		GEngine->OnLevelActorDeleted().RemoveAll(this);
+		GEngine->OnActorMoved().RemoveAll(this);
+		GEngine->OnActorsMoved().RemoveAll(this);
+		GEngine->OnLevelActorFolderChanged().RemoveAll(this);
+	}
+}
+
+TSharedPtr<const FMCPWorldSnapshot> FMCPWorldSnapshotBuilder::GetLatest() const
+{
+	if (!CVarMCPSnapshotEnabled.GetValueOnAnyThread())
+	{
+		return nullptr;
+	}
+
+	FReadScopeLock Lock(LatestLock);
+	return Latest;
+}
+
+void FMCPWorldSnapshotBuilder::MarkAllDirty()
+{
+	bRebuildAll = true;
+	bHasPendingChanges.store(true, std::memory_order_release);
+}
+
+bool FMCPWorldSnapshotBuilder::Tick(float DeltaTime)
+{
+	Refresh();
+	return true;
+}
+
+void FMCPWorldSnapshotBuilder::Refresh()
+{
+	UWorld* World = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
+
+	// 1. Nothing to do unless something changed (a different editor world counts as a change)
+	if (!bRebuildAll && RebuildQueue.Num() == 0 && DirtyActors.Num() == 0 && World == TrackedWorld.Get())
+	{
+		return;
+	}
+
+	MCP_TRACE_SCOPE("MCP Snapshot Refresh");
+	FMCPGameThreadTimeScope GameThreadTime(Metrics.Get());
+
+	// 2. Start over after changes that delegates do not describe per actor
+	if (bRebuildAll || World != TrackedWorld.Get())
+	{
+		Reset();
+		TrackedWorld = World;
+		bRebuildAll = false;
+		bHasPendingChanges.store(true, std::memory_order_release);
+
+		if (World)
+		{
+			for (TActorIterator<AActor> It(World); It; ++It)
+			{
+				RebuildQueue.Add(FObjectKey(*It));
+			}
+		}
+	}
+
+	// 3. A full rebuild is spread across frames; nothing is published until it is complete, so
+	//    reads run on the game thread meanwhile. The clock is read every few actors.
+	if (NextRebuildIndex < RebuildQueue.Num())
+	{
+		constexpr int32 ActorsPerClockCheck = 64;
+		const double EndTime = FPlatformTime::Seconds() + CVarMCPSnapshotRebuildBudgetMs.GetValueOnGameThread() / 1000.0;
+
+		while (NextRebuildIndex < RebuildQueue.Num())
+		{
+			UpdateActor(RebuildQueue[NextRebuildIndex], World);
+			++NextRebuildIndex;
+
+			if (NextRebuildIndex % ActorsPerClockCheck == 0 && FPlatformTime::Seconds() >= EndTime)
+			{
+				return;
+			}
+		}
+	}
+	RebuildQueue.Reset();
+	NextRebuildIndex = 0;
+
+	// 4. Then the actors that changed (including while a rebuild was in progress)
+	for (const FObjectKey& Key : DirtyActors)
+	{
+		UpdateActor(Key, World);
+	}
+	DirtyActors.Reset();
+
+	// 5. Publish, then let reads use the snapshot again
+	Publish(World);
+	bHasPendingChanges.store(false, std::memory_order_release);
+}
+
+void FMCPWorldSnapshotBuilder::UpdateActor(const FObjectKey& Key, const UWorld* World)
+{
+	const AActor* Actor = Cast<AActor>(Key.ResolveObjectPtr());
+	if (!IsValid(Actor) || !World || Actor->GetWorld() != World)
+	{
+		ActorRecords.Remove(Key);
+		return;
+	}
+
+	const TSharedRef<FMCPSnapshotActor> Record = MakeShared<FMCPSnapshotActor>();
+	Record->Info = BuildActorInfo(Actor);
+	Record->ClassIndex = RegisterClass(Actor->GetClass());
+	Record->Tags = Actor->Tags;
+	Record->Location = Actor->GetActorLocation();
+	ActorRecords.Add(Key, Record);
+}
+
+int32 FMCPWorldSnapshotBuilder::RegisterClass(const UClass* Class)
+{
+	if (!Class)
+	{
+		return INDEX_NONE;
+	}
+
+	if (const int32* ExistingIndex = ClassIndexByObject.Find(FObjectKey(Class)))
+	{
+		return *ExistingIndex;
+	}
+
+	// Supers first, so every class in the table can be walked up to AActor
+	FMCPSnapshotClass SnapshotClass;
+	SnapshotClass.Name = Class->GetFName();
+	SnapshotClass.PathName = FName(*Class->GetPathName());
+	SnapshotClass.SuperIndex = Class == AActor::StaticClass() ? INDEX_NONE : RegisterClass(Class->GetSuperClass());
+
+	const int32 Index = Classes.Add(SnapshotClass);
+	ClassIndexByObject.Add(FObjectKey(Class), Index);
+
+	// Native classes win short name clashes, like FindFirstObject(NativeFirst) does
+	const int32* NamedIndex = ClassIndexByName.Find(SnapshotClass.Name);
+	if (!NamedIndex || !Class->HasAnyClassFlags(CLASS_CompiledFromBlueprint))
+	{
+		ClassIndexByName.Add(SnapshotClass.Name, Index);
+	}
+	ClassIndexByPathName.Add(SnapshotClass.PathName, Index);
+
+	return Index;
+}
+
+void FMCPWorldSnapshotBuilder::Publish(const UWorld* World)
+{
+	const TSharedRef<FMCPWorldSnapshot> Snapshot = MakeShared<FMCPWorldSnapshot>();
+	Snapshot->Revision = ++Revision;
+	Snapshot->WorldName = World ? World->GetName() : FString();
+	Snapshot->Classes = Classes;
+	Snapshot->ClassIndexByName = ClassIndexByName;
+	Snapshot->ClassIndexByPathName = ClassIndexByPathName;
+
+	Snapshot->Actors.Reserve(ActorRecords.Num());
+	for (const TPair<FObjectKey, TSharedRef<const FMCPSnapshotActor>>& Pair : ActorRecords)
+	{
+		Snapshot->Actors.Add(Pair.Value);
+	}
+
+	// Readers still holding the previous snapshot keep it alive until they are done
+	FWriteScopeLock Lock(LatestLock);
+	Latest = Snapshot;
+}
+
+void FMCPWorldSnapshotBuilder::Reset()
+{
+	RebuildQueue.Reset();
+	NextRebuildIndex = 0;
+	ActorRecords.Reset();
+	Classes.Reset();
+	ClassIndexByObject.Reset();
+	ClassIndexByName.Reset();
+	ClassIndexByPathName.Reset();
+}
+
+FMCPActorInfo FMCPWorldSnapshotBuilder::BuildActorInfo(const AActor* Actor)
+{
+	FMCPActorInfo ActorInfo;
+	ActorInfo.id = Actor->GetActorGuid().ToString(EGuidFormats::DigitsWithHyphens);
+	ActorInfo.name = Actor->GetName();
+	ActorInfo.label = Actor->GetActorLabel();
+	ActorInfo.className = Actor->GetClass()->GetName();
+	ActorInfo.folder = Actor->GetFolderPath().ToString();
+
+	// Transform
+	ActorInfo.location = ToMCPVector3(Actor->GetActorLocation());
+
+	const FRotator Rotation = Actor->GetActorRotation();
+	ActorInfo.rotation.pitch = Rotation.Pitch;
+	ActorInfo.rotation.yaw = Rotation.Yaw;
+	ActorInfo.rotation.roll = Rotation.Roll;
+
+	ActorInfo.scale = ToMCPVector3(Actor->GetActorScale3D());
+
+	// Bounds of the colliding and non-colliding components
+	FVector BoundsOrigin, BoundsExtent;
+	Actor->GetActorBounds(false, BoundsOrigin, BoundsExtent);
+	ActorInfo.boundsOrigin = ToMCPVector3(BoundsOrigin);
+	ActorInfo.boundsExtent = ToMCPVector3(BoundsExtent);
+
+	// Tags
+	ActorInfo.tags.Reserve(Actor->Tags.Num());
+	for (const FName& Tag : Actor->Tags)
+	{
+		ActorInfo.tags.Add(Tag.ToString());
+	}
+
+	return ActorInfo;
+}
+
+void FMCPWorldSnapshotBuilder::MarkActorDirty(const AActor* Actor)
+{
+	if (Actor)
+	{
+		DirtyActors.Add(FObjectKey(Actor));
+		bHasPendingChanges.store(true, std::memory_order_release);
+	}
+}
+
+void FMCPWorldSnapshotBuilder::HandleActorChanged(AActor* Actor)
+{
+	MarkActorDirty(Actor);
+}
+
+void FMCPWorldSnapshotBuilder::HandleActorsMoved(TArray<AActor*>& Actors)
+{
+	for (const AActor* Actor : Actors)
+	{
+		MarkActorDirty(Actor);
+	}
+}
+
+void FMCPWorldSnapshotBuilder::HandleActorFolderChanged(const AActor* Actor, FName OldPath)
+{
+	MarkActorDirty(Actor);
+}
+
+void FMCPWorldSnapshotBuilder::HandleObjectPropertyChanged(UObject* Object, FPropertyChangedEvent& PropertyChangedEvent)
+{
+	// Component edits (transforms, meshes) change the bounds of their owner
+	if (const UActorComponent* Component = Cast<UActorComponent>(Object))
+	{
+		MarkActorDirty(Component->GetOwner());
+	}
+	else
+	{
+		MarkActorDirty(Cast<AActor>(Object));
+	}
+}
+
+void FMCPWorldSnapshotBuilder::HandleObjectsReplaced(const TMap<UObject*, UObject*>& ReplacementMap)
+{
+	// Blueprint recompiles replace classes and actors
+	MarkAllDirty();
+}
+
+void FMCPWorldSnapshotBuilder::HandlePostUndoRedo()
+{
+	MarkAllDirty();
+}
+
+void FMCPWorldSnapshotBuilder::HandleMapChange(uint32 MapChangeFlags)
+{
+	MarkAllDirty();
+}
+
+void FMCPWorldSnapshotBuilder::HandleMapOpened(const FString& Filename, bool bAsTemplate)
+{
+	MarkAllDirty();
+}
+
+void FMCPWorldSnapshotBuilder::HandleLevelChanged(ULevel* Level, UWorld* World)
+{
+	if (World == TrackedWorld.Get())
+	{
+		MarkAllDirty();
+	}
+}
@@ -0,0 +1,209 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "MCPJsonStructs.h"
+#include "UObject/ObjectKey.h"
+#include <atomic>
+
+class AActor;
+class FMCPMetrics;
+class ULevel;
+class UWorld;
+struct FPropertyChangedEvent;
+
+/**
+ * Actor class known to a world snapshot
+ */
+struct FMCPSnapshotClass
+{
+	FName Name;
+	FName PathName;
+
+	// Index of the super class in the snapshot's class table (INDEX_NONE for AActor)
+	int32 SuperIndex = INDEX_NONE;
+};
+
+/**
+ * Metadata of one actor, captured on the game thread
+ * Records are immutable once built and shared by every snapshot they are part of.
+ */
+struct FMCPSnapshotActor
+{
+	// Prebuilt response entry
+	FMCPActorInfo Info;
+
+	// Fields used by filters (Info holds the same values in response form)
+	int32 ClassIndex = INDEX_NONE;
+	TArray<FName> Tags;
+	FVector Location = FVector::ZeroVector;
+};
+
+/**
+ * Immutable, versioned view of the actors in the editor world
+ * Published by FMCPWorldSnapshotBuilder and safe to read from any thread, since nothing in it
+ * points back to UObjects.
+ */
+class FMCPWorldSnapshot
+{
+public:
+	/** Revision of the snapshot (increases with every publish, 0 = never published) */
+	uint64 Revision = 0;
+
+	/** Name of the world the actors were captured from */
+	FString WorldName;
+
+	/** Actors of the world, in no particular order */
+	TArray<TSharedRef<const FMCPSnapshotActor>> Actors;
+
+	/** Classes of the actors and their super classes up to AActor */
+	TArray<FMCPSnapshotClass> Classes;
+
+	/**
+	 * Find a class by name
+	 * @param ClassName Short class name, or class path name if it contains a '/'
+	 * @return Index into Classes, or INDEX_NONE if no actor in the snapshot has this class or a subclass of it
+	 */
+	int32 FindClass(const FString& ClassName) const;
+
+	/**
+	 * Check whether a class derives from another
+	 * @param ClassIndex Index of the class to test
+	 * @param AncestorIndex Index of the potential ancestor
+	 * @return True if the classes are the same or ClassIndex derives from AncestorIndex
+	 */
+	bool IsChildOf(int32 ClassIndex, int32 AncestorIndex) const;
+
+private:
+	friend class FMCPWorldSnapshotBuilder;
+
+	// Class lookup by short name and by path name
+	TMap<FName, int32> ClassIndexByName;
+	TMap<FName, int32> ClassIndexByPathName;
+};
+
+/**
+ * Keeps a world snapshot up to date with the editor world
+ * Change delegates mark actors dirty; once per frame the dirty records are rebuilt on the game
+ * thread and a new snapshot is published by swapping the shared pointer. Actors that did not
+ * change keep their records, so a publish costs one pointer copy per actor plus the rebuilt actors.
+ * Full rebuilds (undo, map changes, replaced objects) are spread across frames within
+ * mcp.Snapshot.RebuildBudgetMs and published once complete.
+ * Readers grab the latest snapshot from any thread and keep it alive for as long as they need it.
+ */
+class FMCPWorldSnapshotBuilder
+{
+public:
+	FMCPWorldSnapshotBuilder();
+	~FMCPWorldSnapshotBuilder();
+
+	/**
+	 * Get the latest published snapshot
+	 * Thread-safe
+	 * @return Snapshot, or null if snapshots are disabled (mcp.Snapshot.Enabled) or none was published yet
+	 */
+	TSharedPtr<const FMCPWorldSnapshot> GetLatest() const;
+
+	/**
+	 * Check whether the editor changed since the latest publish
+	 * Reads that must observe every completed edit fall back to the game thread while this is true.
+	 * @return True if changes are waiting for the next publish
+	 */
+	bool HasPendingChanges() const { return bHasPendingChanges.load(std::memory_order_acquire); }
+
+	/**
+	 * Rebuild the whole snapshot, starting with the next refresh
+	 * Used for changes the change delegates do not describe per actor (undo, map changes,
+	 * replaced objects); an ongoing rebuild starts over.
+	 */
+	void MarkAllDirty();
+
+	/**
+	 * Rebuild dirty records and publish a new snapshot if anything changed
+	 * A full rebuild only advances by its frame budget; the snapshot is published once it is complete.
+	 * Must be called on the game thread
+	 */
+	void Refresh();
+
+	/**
+	 * Set the metrics refresh time is added to (as MCP game thread time)
+	 * Must be called on the game thread
+	 * @param InMetrics Metrics, or null to stop recording
+	 */
+	void SetMetrics(const TSharedPtr<FMCPMetrics>& InMetrics) { Metrics = InMetrics; }
+
+	/**
+	 * Build the response entry of an actor
+	 * Must be called on the game thread
+	 * @param Actor Actor to convert
+	 * @return Actor information struct
+	 */
+	static FMCPActorInfo BuildActorInfo(const AActor* Actor);
+
+private:
+	/** Game thread tick: publishes pending changes once per frame */
+	bool Tick(float DeltaTime);
+
+	/**
+	 * Rebuild the record of one actor, or drop it if the actor left the world
+	 * @param Key Key of the actor
+	 * @param World World being tracked
+	 */
+	void UpdateActor(const FObjectKey& Key, const UWorld* World);
+
+	/**
+	 * Add a class and its super classes to the class table
+	 * @param Class Actor class
+	 * @return Index of the class
+	 */
+	int32 RegisterClass(const UClass* Class);
+
+	/** Publish the current records as a new snapshot */
+	void Publish(const UWorld* World);
+
+	/** Drop every record and class so the next refresh rebuilds from scratch */
+	void Reset();
+
+	// Editor change handlers
+	void MarkActorDirty(const AActor* Actor);
+	void HandleActorChanged(AActor* Actor);
+	void HandleActorsMoved(TArray<AActor*>& Actors);
+	void HandleActorFolderChanged(const AActor* Actor, FName OldPath);
+	void HandleObjectPropertyChanged(UObject* Object, FPropertyChangedEvent& PropertyChangedEvent);
+	void HandleObjectsReplaced(const TMap<UObject*, UObject*>& ReplacementMap);
+	void HandlePostUndoRedo();
+	void HandleMapChange(uint32 MapChangeFlags);
+	void HandleMapOpened(const FString& Filename, bool bAsTemplate);
+	void HandleLevelChanged(ULevel* Level, UWorld* World);
+
+	// Game thread state
+	TMap<FObjectKey, TSharedRef<const FMCPSnapshotActor>> ActorRecords;
+	TSet<FObjectKey> DirtyActors;
+	bool bRebuildAll = true;
+
+	// Actors of a full rebuild in progress, and the next one to rebuild
+	TArray<FObjectKey> RebuildQueue;
+	int32 NextRebuildIndex = 0;
+	TWeakObjectPtr<const UWorld> TrackedWorld;
+
+	TArray<FMCPSnapshotClass> Classes;
+	TMap<FObjectKey, int32> ClassIndexByObject;
+	TMap<FName, int32> ClassIndexByName;
+	TMap<FName, int32> ClassIndexByPathName;
+
+	uint64 Revision = 0;
+
+	// Metrics of the running HTTP server (null while it is stopped)
+	TSharedPtr<FMCPMetrics> Metrics;
+
+	// Published state
+	std::atomic<bool> bHasPendingChanges{true};
+
+	mutable FRWLock LatestLock;
+	TSharedPtr<const FMCPWorldSnapshot> Latest;
+
+	// Core ticker registration
+	FTSTicker::FDelegateHandle TickerHandle;
+};
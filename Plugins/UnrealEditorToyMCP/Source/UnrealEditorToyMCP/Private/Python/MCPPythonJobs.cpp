@@ -0,0 +1,70 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "MCPPythonJobs.h"
+#include "MCPJsonStructs.h"
+
+FMCPPythonJobInfo FMCPPythonJob::ToInfo() const
+{
+	FMCPPythonJobInfo Info;
+	Info.id = Id;
+	Info.script = ScriptName;
+	Info.steps = Steps;
+	Info.progress = Progress;
+	Info.message = Message;
+	Info.elapsedSeconds = FPlatformTime::Seconds() - StartTime;
+	Info.cancelRequested = bCancelRequested;
+	return Info;
+}
+
+TSharedPtr<FMCPPythonJob> FMCPPythonJobRegistry::Add(const FString& RequestedId, const FString& ScriptName, FString& OutError)
+{
+	check(IsInGameThread());
+
+	FString Id = RequestedId;
+	if (Id.IsEmpty())
+	{
+		do
+		{
+			Id = FString::Printf(TEXT("python-%u"), NextJobNumber++);
+		}
+		while (Jobs.Contains(Id));
+	}
+	else if (Jobs.Contains(Id))
+	{
+		OutError = FString::Printf(TEXT("Job '%s' is already running"), *Id);
+		return nullptr;
+	}
+
+	const TSharedRef<FMCPPythonJob> Job = MakeShared<FMCPPythonJob>();
+	Job->Id = Id;
+	Job->ScriptName = ScriptName;
+	Job->StartTime = FPlatformTime::Seconds();
+	Jobs.Add(Id, Job);
+	return Job;
+}
+
+void FMCPPythonJobRegistry::Remove(const FString& Id)
+{
+	check(IsInGameThread());
+	Jobs.Remove(Id);
+}
+
+TSharedPtr<FMCPPythonJob> FMCPPythonJobRegistry::Find(const FString& Id) const
+{
+	check(IsInGameThread());
+	const TSharedRef<FMCPPythonJob>* Job = Jobs.Find(Id);
+	return Job ? Job->ToSharedPtr() : nullptr;
+}
+
+TArray<TSharedRef<FMCPPythonJob>> FMCPPythonJobRegistry::GetAll() const
+{
+	check(IsInGameThread());
+
+	TArray<TSharedRef<FMCPPythonJob>> Result;
+	Jobs.GenerateValueArray(Result);
+	Result.Sort([](const TSharedRef<FMCPPythonJob>& A, const TSharedRef<FMCPPythonJob>& B)
+	{
+		return A->StartTime < B->StartTime;
+	});
+	return Result;
+}
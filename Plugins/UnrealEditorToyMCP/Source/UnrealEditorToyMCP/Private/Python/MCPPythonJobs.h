@@ -0,0 +1,78 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FMCPPythonJobInfo;
+
+/**
+ * execute_python script in progress
+ * Generator scripts stay registered across the frames they are stepped in.
+ */
+struct FMCPPythonJob
+{
+	FString Id;
+	FString ScriptName;
+	double StartTime = 0.0;
+
+	// Frames the script has been stepped in
+	int32 Steps = 0;
+
+	// Progress and message from the script's last yield (progress 0-1, negative if unknown)
+	float Progress = -1.0f;
+	FString Message;
+
+	// Set by python_job; the script stops at its next yield
+	bool bCancelRequested = false;
+
+	/**
+	 * Describe the job for a response
+	 * @return Job information struct
+	 */
+	FMCPPythonJobInfo ToInfo() const;
+};
+
+/**
+ * Python jobs in progress
+ * Shared by execute_python, which registers and steps them, and python_job, which reports and
+ * cancels them. Game thread only.
+ */
+class FMCPPythonJobRegistry
+{
+public:
+	/**
+	 * Register a job
+	 * @param RequestedId Id chosen by the client (a unique id is generated if empty)
+	 * @param ScriptName Name of the script
+	 * @param OutError Error message if the id is already in use
+	 * @return Registered job, or null on error
+	 */
+	TSharedPtr<FMCPPythonJob> Add(const FString& RequestedId, const FString& ScriptName, FString& OutError);
+
+	/**
+	 * Unregister a job once it completed
+	 * @param Id Id of the job
+	 */
+	void Remove(const FString& Id);
+
+	/**
+	 * Find a job
+	 * @param Id Id of the job
+	 * @return Job, or null if no job with this id is in progress
+	 */
+	TSharedPtr<FMCPPythonJob> Find(const FString& Id) const;
+
+	/**
+	 * Get every job in progress
+	 * @return Jobs, oldest first
+	 */
+	TArray<TSharedRef<FMCPPythonJob>> GetAll() const;
+
+	/** Number of jobs in progress */
+	int32 Num() const { return Jobs.Num(); }
+
+private:
+	TMap<FString, TSharedRef<FMCPPythonJob>> Jobs;
+	uint32 NextJobNumber = 1;
+};
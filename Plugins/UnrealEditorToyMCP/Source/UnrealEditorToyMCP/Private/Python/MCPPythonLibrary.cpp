@@ -0,0 +1,176 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "MCPPythonLibrary.h"
+#include "HAL/IConsoleManager.h"
+#include "UnrealEditorMCP.h"
+
+static TAutoConsoleVariable<float> CVarMCPPythonSessionIdleTimeout(
+	TEXT("mcp.Python.SessionIdleTimeoutSeconds"),
+	1800.0f,
+	TEXT("Seconds an execute_python session may stay unused before mcp_runtime drops its namespace. 0 keeps sessions until they are closed."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarMCPPythonMaxOutputBytes(
+	TEXT("mcp.Python.MaxOutputBytes"),
+	1024 * 1024,
+	TEXT("Bytes of output kept per execute_python script. Beyond it, the first and last half are kept and the middle is dropped."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<bool> CVarMCPPythonEchoOutput(
+	TEXT("mcp.Python.EchoOutput"),
+	false,
+	TEXT("Echo execute_python output to the log line by line while the script runs (debugging aid)."),
+	ECVF_Default);
+
+namespace
+{
+	// Invocation of the script that is running (game thread only)
+	FMCPPythonInvocation* CurrentInvocation = nullptr;
+}
+
+FMCPPythonInvocationScope::FMCPPythonInvocationScope(FMCPPythonInvocation& Invocation)
+	: PreviousInvocation(CurrentInvocation)
+{
+	check(IsInGameThread());
+	CurrentInvocation = &Invocation;
+}
+
+FMCPPythonInvocationScope::~FMCPPythonInvocationScope()
+{
+	CurrentInvocation = PreviousInvocation;
+}
+
+FString UMCPPythonLibrary::GetScriptName()
+{
+	return CurrentInvocation ? CurrentInvocation->ScriptName : FString();
+}
+
+FString UMCPPythonLibrary::GetScriptSource()
+{
+	return CurrentInvocation ? CurrentInvocation->Source : FString();
+}
+
+FString UMCPPythonLibrary::GetScriptHash()
+{
+	return CurrentInvocation ? CurrentInvocation->SourceHash : FString();
+}
+
+FString UMCPPythonLibrary::GetScriptArgs()
+{
+	return CurrentInvocation ? CurrentInvocation->ArgsJson : FString();
+}
+
+int32 UMCPPythonLibrary::GetCodeCacheCapacity()
+{
+	return CurrentInvocation ? CurrentInvocation->CodeCacheCapacity : 0;
+}
+
+void UMCPPythonLibrary::ReportCodeCache(const bool bHit, const int32 NumEntries)
+{
+	if (CurrentInvocation)
+	{
+		CurrentInvocation->bCodeCacheHit = bHit;
+		CurrentInvocation->CodeCacheEntries = NumEntries;
+	}
+}
+
+FString UMCPPythonLibrary::GetSessionId()
+{
+	return CurrentInvocation ? CurrentInvocation->SessionId : FString();
+}
+
+FString UMCPPythonLibrary::GetSessionAction()
+{
+	return CurrentInvocation ? CurrentInvocation->SessionAction : FString();
+}
+
+float UMCPPythonLibrary::GetSessionIdleTimeout()
+{
+	return CVarMCPPythonSessionIdleTimeout.GetValueOnGameThread();
+}
+
+void UMCPPythonLibrary::ReportSessions(const FString& SessionsJson)
+{
+	if (CurrentInvocation)
+	{
+		CurrentInvocation->SessionsJson = SessionsJson;
+	}
+}
+
+int32 UMCPPythonLibrary::GetOutputCapacity()
+{
+	return CVarMCPPythonMaxOutputBytes.GetValueOnGameThread();
+}
+
+bool UMCPPythonLibrary::IsOutputIncluded()
+{
+	return CurrentInvocation ? CurrentInvocation->bIncludeOutput : true;
+}
+
+bool UMCPPythonLibrary::IsOutputEchoEnabled()
+{
+	return CVarMCPPythonEchoOutput.GetValueOnGameThread();
+}
+
+void UMCPPythonLibrary::EchoOutput(const FString& Line)
+{
+	UE_LOG(LogUnrealEditorMCP, Log, TEXT("UnrealEditorMCP: [%s] %s"),
+	       CurrentInvocation ? *CurrentInvocation->ScriptName : TEXT("python"), *Line);
+}
+
+void UMCPPythonLibrary::ReportOutput(const FString& Output, const int64 TotalBytes, const int64 TruncatedBytes)
+{
+	if (CurrentInvocation)
+	{
+		CurrentInvocation->Output = Output;
+		CurrentInvocation->OutputBytes = TotalBytes;
+		CurrentInvocation->OutputTruncatedBytes = TruncatedBytes;
+	}
+}
+
+void UMCPPythonLibrary::ReportResult(const FString& ResultJson)
+{
+	if (CurrentInvocation)
+	{
+		CurrentInvocation->ResultJson = ResultJson;
+	}
+}
+
+FString UMCPPythonLibrary::GetJobId()
+{
+	return CurrentInvocation ? CurrentInvocation->JobId : FString();
+}
+
+double UMCPPythonLibrary::GetStepBudget()
+{
+	return CurrentInvocation ? CurrentInvocation->StepBudgetSeconds : 0.0;
+}
+
+bool UMCPPythonLibrary::IsCancelRequested()
+{
+	return CurrentInvocation && CurrentInvocation->bCancelRequested;
+}
+
+void UMCPPythonLibrary::ReportJobState(const bool bDone, const bool bCancelled, const float Progress, const FString& Message)
+{
+	if (CurrentInvocation)
+	{
+		CurrentInvocation->bJobDone = bDone;
+		CurrentInvocation->bJobCancelled = bCancelled;
+		CurrentInvocation->JobProgress = Progress;
+		CurrentInvocation->JobMessage = Message;
+	}
+}
+
+double UMCPPythonLibrary::GetTimeout()
+{
+	return CurrentInvocation ? CurrentInvocation->TimeoutSeconds : 0.0;
+}
+
+void UMCPPythonLibrary::ReportTimeout()
+{
+	if (CurrentInvocation)
+	{
+		CurrentInvocation->bTimedOut = true;
+	}
+}
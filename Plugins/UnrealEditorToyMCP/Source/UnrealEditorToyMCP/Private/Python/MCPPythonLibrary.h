@@ -0,0 +1,180 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Kismet/BlueprintFunctionLibrary.h"
+#include "MCPPythonLibrary.generated.h"
+
+/**
+ * Script run by execute_python, as seen by the mcp_runtime Python module
+ * Filled in by the command and read back through UMCPPythonLibrary while the script runs.
+ */
+struct FMCPPythonInvocation
+{
+	// Inputs
+	FString ScriptName;
+	FString Source;
+	FString SourceHash;
+	FString ArgsJson;
+	int32 CodeCacheCapacity = 0;
+	FString SessionId;
+	FString SessionAction;
+	bool bIncludeOutput = true;
+	FString JobId;
+	double StepBudgetSeconds = 0.0;
+	bool bCancelRequested = false;
+	double TimeoutSeconds = 0.0;
+
+	// Outputs reported by mcp_runtime
+	bool bCodeCacheHit = false;
+	int32 CodeCacheEntries = 0;
+	FString SessionsJson;
+	FString Output;
+	int64 OutputBytes = 0;
+	int64 OutputTruncatedBytes = 0;
+	FString ResultJson;
+	bool bJobDone = true;
+	bool bJobCancelled = false;
+	float JobProgress = -1.0f;
+	FString JobMessage;
+	bool bTimedOut = false;
+};
+
+/**
+ * Bridge between execute_python and the mcp_runtime Python module (unreal.MCPPythonLibrary)
+ * Only valid while a script is running; every function must be called on the game thread.
+ */
+UCLASS()
+class UMCPPythonLibrary : public UBlueprintFunctionLibrary
+{
+	GENERATED_BODY()
+
+public:
+	/** Name of the running script (used as the file name in tracebacks) */
+	UFUNCTION(meta = (ScriptCallable))
+	static FString GetScriptName();
+
+	/** Source of the running script */
+	UFUNCTION(meta = (ScriptCallable))
+	static FString GetScriptSource();
+
+	/** Content hash of the running script's source (compiled code cache key) */
+	UFUNCTION(meta = (ScriptCallable))
+	static FString GetScriptHash();
+
+	/** Arguments of the running script as a JSON object (empty if none were passed) */
+	UFUNCTION(meta = (ScriptCallable))
+	static FString GetScriptArgs();
+
+	/** Maximum number of compiled scripts to keep (mcp.Python.CodeCacheSize) */
+	UFUNCTION(meta = (ScriptCallable))
+	static int32 GetCodeCacheCapacity();
+
+	/**
+	 * Report how the running script's code was obtained
+	 * @param bHit True if the compiled code came from the cache
+	 * @param NumEntries Number of compiled scripts in the cache
+	 */
+	UFUNCTION(meta = (ScriptCallable))
+	static void ReportCodeCache(bool bHit, int32 NumEntries);
+
+	/** Session the running script belongs to (empty for a fresh namespace) */
+	UFUNCTION(meta = (ScriptCallable))
+	static FString GetSessionId();
+
+	/** Session action requested by python_session ("list", "reset", "close" or "close_all") */
+	UFUNCTION(meta = (ScriptCallable))
+	static FString GetSessionAction();
+
+	/** Seconds a session may stay unused before it is closed (mcp.Python.SessionIdleTimeoutSeconds, 0 = never) */
+	UFUNCTION(meta = (ScriptCallable))
+	static float GetSessionIdleTimeout();
+
+	/**
+	 * Report the state of sessions after a session action
+	 * @param SessionsJson JSON array of FMCPPythonSessionInfo objects
+	 */
+	UFUNCTION(meta = (ScriptCallable))
+	static void ReportSessions(const FString& SessionsJson);
+
+	/** Maximum number of output bytes to keep per script (mcp.Python.MaxOutputBytes) */
+	UFUNCTION(meta = (ScriptCallable))
+	static int32 GetOutputCapacity();
+
+	/** Whether the caller wants the script's output (if not, output is only counted) */
+	UFUNCTION(meta = (ScriptCallable))
+	static bool IsOutputIncluded();
+
+	/** Whether output lines should be echoed to the log as they are printed (mcp.Python.EchoOutput) */
+	UFUNCTION(meta = (ScriptCallable))
+	static bool IsOutputEchoEnabled();
+
+	/**
+	 * Echo one line of script output to the log
+	 * @param Line Line without its terminator
+	 */
+	UFUNCTION(meta = (ScriptCallable))
+	static void EchoOutput(const FString& Line);
+
+	/**
+	 * Report the output the running script printed
+	 * @param Output Kept output (head and tail, with a marker where bytes were dropped)
+	 * @param TotalBytes Bytes printed by the script
+	 * @param TruncatedBytes Bytes dropped from the middle of the output
+	 */
+	UFUNCTION(meta = (ScriptCallable))
+	static void ReportOutput(const FString& Output, int64 TotalBytes, int64 TruncatedBytes);
+
+	/**
+	 * Report the result value of the running script
+	 * Not called if the script produced no result.
+	 * @param ResultJson Result serialized as JSON
+	 */
+	UFUNCTION(meta = (ScriptCallable))
+	static void ReportResult(const FString& ResultJson);
+
+	/** Id of the job the running script belongs to */
+	UFUNCTION(meta = (ScriptCallable))
+	static FString GetJobId();
+
+	/** Seconds a generator script may run before it has to yield back to the editor */
+	UFUNCTION(meta = (ScriptCallable))
+	static double GetStepBudget();
+
+	/** Whether the job was cancelled (python_job) and should stop at its next yield */
+	UFUNCTION(meta = (ScriptCallable))
+	static bool IsCancelRequested();
+
+	/**
+	 * Report the state of a generator script after a step
+	 * Not called for plain scripts, which always complete in one step.
+	 * @param bDone True if the script finished or was cancelled
+	 * @param bCancelled True if the script stopped because it was cancelled
+	 * @param Progress Progress the script last yielded (0-1, negative if unknown)
+	 * @param Message Message the script last yielded
+	 */
+	UFUNCTION(meta = (ScriptCallable))
+	static void ReportJobState(bool bDone, bool bCancelled, float Progress, const FString& Message);
+
+	/** Seconds the running script may hold the game thread before the watchdog interrupts it (0 = no limit) */
+	UFUNCTION(meta = (ScriptCallable))
+	static double GetTimeout();
+
+	/** Report that the watchdog interrupted the running script */
+	UFUNCTION(meta = (ScriptCallable))
+	static void ReportTimeout();
+};
+
+/**
+ * Makes an invocation visible to UMCPPythonLibrary for the lifetime of the scope
+ */
+class FMCPPythonInvocationScope
+{
+public:
+	explicit FMCPPythonInvocationScope(FMCPPythonInvocation& Invocation);
+	~FMCPPythonInvocationScope();
+
+private:
+	FMCPPythonInvocation* PreviousInvocation;
+};
@@ -0,0 +1,211 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "MCPWorldArrayLibrary.h"
+#include "Commands/ActorQueryFilter.h"
+#include "Commands/ActorTransformBatch.h"
+#include "Editor.h"
+#include "EngineUtils.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "Misc/Base64.h"
+#include "ScopedTransaction.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+#define LOCTEXT_NAMESPACE "MCPWorldArrayLibrary"
+
+namespace
+{
+	// Vector arrays per captured actor: location, rotation, scale, bounds origin, bounds extent
+	constexpr int32 NumCapturedVectors = 5;
+
+	UWorld* GetEditorWorld()
+	{
+		return GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
+	}
+
+	void AppendVector(TArray<double>& Values, const double X, const double Y, const double Z)
+	{
+		Values.Add(X);
+		Values.Add(Y);
+		Values.Add(Z);
+	}
+}
+
+void UMCPWorldArrayLibrary::CaptureActorArrays(const FString& FilterJson, int32& OutCount, FString& OutActorIds,
+                                               FString& OutClassNames, FString& OutData, FString& OutError)
+{
+	OutCount = 0;
+
+	// 1. Parse the filter (same criteria as get_actors_in_level)
+	TSharedPtr<FJsonObject> FilterParams;
+	if (!FilterJson.IsEmpty() && !FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(FilterJson), FilterParams))
+	{
+		OutError = TEXT("Filter is not a JSON object");
+		return;
+	}
+
+	FActorQueryFilter Filter;
+	if (!FActorQueryFilter::Parse(FilterParams, Filter, OutError))
+	{
+		return;
+	}
+
+	UWorld* EditorWorld = GetEditorWorld();
+	if (!EditorWorld)
+	{
+		OutError = TEXT("No editor world available");
+		return;
+	}
+
+	// 2. Gather every matching actor into one array per component
+	TArray<TArray<double>> Vectors;
+	Vectors.SetNum(NumCapturedVectors);
+	TArray<int32> ClassIndices;
+	TMap<const UClass*, int32> ClassIndexByClass;
+	TStringBuilder<4096> ActorIds;
+	TStringBuilder<256> ClassNames;
+
+	for (TActorIterator<AActor> It(EditorWorld); It; ++It)
+	{
+		const AActor* Actor = *It;
+		if (!Filter.Matches(Actor))
+		{
+			continue;
+		}
+
+		const FVector Location = Actor->GetActorLocation();
+		const FRotator Rotation = Actor->GetActorRotation();
+		const FVector Scale = Actor->GetActorScale3D();
+		FVector BoundsOrigin, BoundsExtent;
+		Actor->GetActorBounds(false, BoundsOrigin, BoundsExtent);
+
+		AppendVector(Vectors[0], Location.X, Location.Y, Location.Z);
+		AppendVector(Vectors[1], Rotation.Pitch, Rotation.Yaw, Rotation.Roll);
+		AppendVector(Vectors[2], Scale.X, Scale.Y, Scale.Z);
+		AppendVector(Vectors[3], BoundsOrigin.X, BoundsOrigin.Y, BoundsOrigin.Z);
+		AppendVector(Vectors[4], BoundsExtent.X, BoundsExtent.Y, BoundsExtent.Z);
+
+		const UClass* Class = Actor->GetClass();
+		int32* ClassIndex = ClassIndexByClass.Find(Class);
+		if (!ClassIndex)
+		{
+			ClassIndex = &ClassIndexByClass.Add(Class, ClassIndexByClass.Num());
+			if (ClassNames.Len() > 0)
+			{
+				ClassNames.AppendChar(TEXT('\n'));
+			}
+			ClassNames.Append(Class->GetName());
+		}
+		ClassIndices.Add(*ClassIndex);
+
+		if (OutCount > 0)
+		{
+			ActorIds.AppendChar(TEXT('\n'));
+		}
+		ActorIds.Append(Actor->GetActorGuid().ToString(EGuidFormats::DigitsWithHyphens));
+		++OutCount;
+	}
+
+	// 3. Pack the arrays back to back and encode them once
+	TArray<uint8> Buffer;
+	Buffer.Reserve(OutCount * (NumCapturedVectors * 3 * sizeof(double) + sizeof(int32)));
+	for (const TArray<double>& Values : Vectors)
+	{
+		Buffer.Append(reinterpret_cast<const uint8*>(Values.GetData()), Values.Num() * sizeof(double));
+	}
+	Buffer.Append(reinterpret_cast<const uint8*>(ClassIndices.GetData()), ClassIndices.Num() * sizeof(int32));
+
+	OutActorIds = ActorIds.ToString();
+	OutClassNames = ClassNames.ToString();
+	OutData = FBase64::Encode(Buffer.GetData(), Buffer.Num());
+}
+
+int32 UMCPWorldArrayLibrary::ApplyActorTransforms(const FString& ActorIds, const FString& Data, const bool bLocation,
+                                                  const bool bRotation, const bool bScale, FString& OutError)
+{
+	// 1. Parse ids and check the data holds N x 3 doubles per component
+	TArray<FString> IdStrings;
+	ActorIds.ParseIntoArray(IdStrings, TEXT("\n"));
+
+	TMap<FGuid, int32> IndexById;
+	IndexById.Reserve(IdStrings.Num());
+	for (int32 Index = 0; Index < IdStrings.Num(); ++Index)
+	{
+		FGuid Id;
+		if (!FGuid::Parse(IdStrings[Index], Id))
+		{
+			OutError = FString::Printf(TEXT("Invalid actor id: %s"), *IdStrings[Index]);
+			return 0;
+		}
+		IndexById.Add(Id, Index);
+	}
+
+	TArray<uint8> Buffer;
+	if (!FBase64::Decode(Data, Buffer))
+	{
+		OutError = TEXT("Transform data is not valid base64");
+		return 0;
+	}
+
+	const int32 NumActors = IdStrings.Num();
+	const int32 NumComponents = (bLocation ? 1 : 0) + (bRotation ? 1 : 0) + (bScale ? 1 : 0);
+	if (Buffer.Num() != NumActors * NumComponents * 3 * static_cast<int32>(sizeof(double)))
+	{
+		OutError = FString::Printf(TEXT("Expected %d x 3 values for each of %d components, got %d bytes"),
+		                           NumActors, NumComponents, Buffer.Num());
+		return 0;
+	}
+
+	UWorld* EditorWorld = GetEditorWorld();
+	if (!EditorWorld)
+	{
+		OutError = TEXT("No editor world available");
+		return 0;
+	}
+
+	// 2. Each component is a contiguous N x 3 block, in the order location, rotation, scale
+	const double* Values = reinterpret_cast<const double*>(Buffer.GetData());
+	const double* Locations = bLocation ? Values : nullptr;
+	const double* Rotations = bRotation ? Values + NumActors * 3 * (bLocation ? 1 : 0) : nullptr;
+	const double* Scales = bScale ? Values + NumActors * 3 * (NumComponents - 1) : nullptr;
+
+	// 3. Apply to the actors found in one pass over the world, notifying the editor once at the end
+	const FScopedTransaction Transaction(LOCTEXT("SetActorTransforms", "MCP: Set Actor Transforms"));
+	FActorTransformBatch Batch;
+
+	for (TActorIterator<AActor> It(EditorWorld); It && Batch.Num() < NumActors; ++It)
+	{
+		AActor* Actor = *It;
+		const int32* Index = IndexById.Find(Actor->GetActorGuid());
+		if (!Index)
+		{
+			continue;
+		}
+
+		FTransform Transform = Actor->GetActorTransform();
+		if (Locations)
+		{
+			const double* Location = Locations + *Index * 3;
+			Transform.SetLocation(FVector(Location[0], Location[1], Location[2]));
+		}
+		if (Rotations)
+		{
+			const double* Rotation = Rotations + *Index * 3;
+			Transform.SetRotation(FRotator(Rotation[0], Rotation[1], Rotation[2]).Quaternion());
+		}
+		if (Scales)
+		{
+			const double* Scale = Scales + *Index * 3;
+			Transform.SetScale3D(FVector(Scale[0], Scale[1], Scale[2]));
+		}
+
+		Batch.Apply(*Actor, Transform);
+	}
+
+	const int32 NumApplied = Batch.Num();
+	Batch.Finish();
+	return NumApplied;
+}
+
+#undef LOCTEXT_NAMESPACE
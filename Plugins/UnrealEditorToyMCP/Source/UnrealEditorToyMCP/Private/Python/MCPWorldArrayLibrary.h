@@ -0,0 +1,51 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Kismet/BlueprintFunctionLibrary.h"
+#include "MCPWorldArrayLibrary.generated.h"
+
+/**
+ * Bulk access to actor transforms for Python scripts (unreal.MCPWorldArrayLibrary)
+ * Arrays cross the C++/Python boundary as one base64-encoded buffer of native doubles and ints,
+ * which mcp_runtime decodes in a single call and wraps in numpy (or memoryview) views, instead
+ * of converting every value through reflection. Scripts use it through mcp.actor_arrays() and
+ * mcp.set_actor_transforms(). Every function must be called on the game thread.
+ */
+UCLASS()
+class UMCPWorldArrayLibrary : public UBlueprintFunctionLibrary
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * Capture the actors of the editor world as packed arrays
+	 * Data holds, for N actors: location, rotation (pitch, yaw, roll), scale, bounds origin and
+	 * bounds extent as N x 3 doubles each, followed by N int32 indices into OutClassNames.
+	 * @param FilterJson Actor filter as a JSON object (class_name, tag, box_min, box_max; empty = all actors)
+	 * @param OutCount Number of actors captured (N)
+	 * @param OutActorIds Actor GUIDs, one per line, in array order
+	 * @param OutClassNames Names of the actors' classes, one per line
+	 * @param OutData Base64-encoded packed arrays
+	 * @param OutError Error message (empty on success)
+	 */
+	UFUNCTION(meta = (ScriptCallable))
+	static void CaptureActorArrays(const FString& FilterJson, int32& OutCount, FString& OutActorIds, FString& OutClassNames,
+	                               FString& OutData, FString& OutError);
+
+	/**
+	 * Set the transforms of many actors in one undoable transaction
+	 * Editor move notifications are sent once for the whole batch (see FActorTransformBatch).
+	 * @param ActorIds Actor GUIDs, one per line
+	 * @param Data Base64-encoded N x 3 doubles for each component set below, in the order location, rotation, scale
+	 * @param bLocation True if Data contains locations
+	 * @param bRotation True if Data contains rotations (pitch, yaw, roll)
+	 * @param bScale True if Data contains scales
+	 * @param OutError Error message (empty on success)
+	 * @return Number of actors updated (ids not found in the world are skipped)
+	 */
+	UFUNCTION(meta = (ScriptCallable))
+	static int32 ApplyActorTransforms(const FString& ActorIds, const FString& Data, bool bLocation, bool bRotation, bool bScale,
+	                                  FString& OutError);
+};
@@ -2,16 +2,18 @@
 
 #include "UnrealEditorMCP.h"
 
+DEFINE_LOG_CATEGORY(LogUnrealEditorMCP);
+
 #define LOCTEXT_NAMESPACE "FUnrealEditorMCPModule"
 
 void FUnrealEditorMCPModule::StartupModule()
 {
-	UE_LOG(LogTemp, Display, TEXT("UnrealEditorMCP: Module loaded"));
+	UE_LOG(LogUnrealEditorMCP, Display, TEXT("UnrealEditorMCP: Module loaded"));
 }
 
 void FUnrealEditorMCPModule::ShutdownModule()
 {
-	UE_LOG(LogTemp, Display, TEXT("UnrealEditorMCP: Module unloaded"));
+	UE_LOG(LogUnrealEditorMCP, Display, TEXT("UnrealEditorMCP: Module unloaded"));
 }
 
 #undef LOCTEXT_NAMESPACE
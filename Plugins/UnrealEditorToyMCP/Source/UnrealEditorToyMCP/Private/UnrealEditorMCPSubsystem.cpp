@@ -3,6 +3,8 @@
 
 #include "UnrealEditorMCPSubsystem.h"
 #include "HTTP/UnrealEditorMCPHttpServer.h"
+#include "MCPWorldSnapshot.h"
+#include "UnrealEditorMCP.h"
 
 #define MCP_HTTP_SERVER_PORT 3000
 
@@ -16,7 +18,10 @@ UUnrealEditorMCPSubsystem::~UUnrealEditorMCPSubsystem()
 
 void UUnrealEditorMCPSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
-	UE_LOG(LogTemp, Display, TEXT("UnrealEditorMCP: Initializing"));
+	UE_LOG(LogUnrealEditorMCP, Display, TEXT("UnrealEditorMCP: Initializing"));
+
+	// Start tracking the editor world before any request can read it
+	WorldSnapshot = MakeShared<FMCPWorldSnapshotBuilder>();
 
 	// Start HTTP server
 	StartHttpServer();
@@ -24,8 +29,9 @@ void UUnrealEditorMCPSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 
 void UUnrealEditorMCPSubsystem::Deinitialize()
 {
-	UE_LOG(LogTemp, Display, TEXT("UnrealEditorMCP: Shutting down"));
+	UE_LOG(LogUnrealEditorMCP, Display, TEXT("UnrealEditorMCP: Shutting down"));
 	StopHttpServer();
+	WorldSnapshot.Reset();
 }
 
 // Start HTTP server
@@ -33,15 +39,15 @@ void UUnrealEditorMCPSubsystem::StartHttpServer()
 {
 	if (HttpServer.IsValid())
 	{
-		UE_LOG(LogTemp, Warning, TEXT("UnrealEditorMCP: HTTP Server already running"));
+		UE_LOG(LogUnrealEditorMCP, Warning, TEXT("UnrealEditorMCP: HTTP Server already running"));
 		return;
 	}
 
-	HttpServer = MakeShared<FUnrealEditorMCPHttpServer>();
+	HttpServer = MakeShared<FUnrealEditorMCPHttpServer>(WorldSnapshot.ToSharedRef());
 
 	if (!HttpServer->Start(MCP_HTTP_SERVER_PORT))
 	{
-		UE_LOG(LogTemp, Error, TEXT("UnrealEditorMCP: Failed to start HTTP Server on port %d"), MCP_HTTP_SERVER_PORT);
+		UE_LOG(LogUnrealEditorMCP, Error, TEXT("UnrealEditorMCP: Failed to start HTTP Server on port %d"), MCP_HTTP_SERVER_PORT);
 		HttpServer.Reset();
 	}
 }
@@ -97,6 +97,25 @@ struct FMCPStatusResponse
 
 	UPROPERTY()
 	FString engineVersion;
+
+	// スケジューラのティックレート (Hz、バックグラウンドでスロットリングされると低下する)
+	UPROPERTY()
+	float tickRate = 0.0f;
+
+	// MCP がエディタのバックグラウンド CPU スロットリングを抑止中か
+	UPROPERTY()
+	bool cpuThrottlingSuspended = false;
+
+	// 実行中の Python ジョブ数 (詳細は python_job)
+	UPROPERTY()
+	int32 pythonJobs = 0;
+
+	// 最新のワールドスナップショット (無効時は 0)
+	UPROPERTY()
+	int64 snapshotRevision = 0;
+
+	UPROPERTY()
+	int32 snapshotActorCount = 0;
 };
 
 // エラーレスポンス
@@ -112,8 +131,75 @@ struct FMCPErrorResponse
 	FString error;
 };
 
+// GET /mcp/debug/requests のリクエスト要約
+USTRUCT()
+struct FMCPRequestLogEntry
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	int64 id = 0;
+
+	UPROPERTY()
+	FString command;
+
+	UPROPERTY()
+	int32 status = 0;
+
+	UPROPERTY()
+	bool error = false;
+
+	UPROPERTY()
+	int32 requestBytes = 0;
+
+	UPROPERTY()
+	int32 responseBytes = 0;
+
+	// 完了時刻 (ISO 8601, UTC)
+	UPROPERTY()
+	FString completedAt;
+
+	// 各段階の所要時間 (ミリ秒、実行されなかった段階は -1)
+	UPROPERTY()
+	float parseMs = -1.0f;
+
+	UPROPERTY()
+	float queueMs = -1.0f;
+
+	UPROPERTY()
+	float gameThreadWaitMs = -1.0f;
+
+	UPROPERTY()
+	float executeMs = -1.0f;
+
+	UPROPERTY()
+	float serializeMs = -1.0f;
+
+	UPROPERTY()
+	float totalMs = -1.0f;
+};
+
+// GET /mcp/debug/requests のレスポンス
+USTRUCT()
+struct FMCPDebugRequestsResponse
+{
+	GENERATED_BODY()
+
+	// 起動後に記録されたリクエスト数 (サンプリング後)
+	UPROPERTY()
+	int64 totalRecorded = 0;
+
+	// mcp.RequestLog.SampleEvery の現在値
+	UPROPERTY()
+	int32 sampleEvery = 1;
+
+	// 新しい順
+	UPROPERTY()
+	TArray<FMCPRequestLogEntry> requests;
+};
+
 // ============================================================================
-// Command レスポンス用の構造体
+// パラメータとレスポンスで共通の構造体
 // ============================================================================
 
 // Vector3 (Location, Scale など用)
@@ -148,18 +234,277 @@ struct FMCPRotator
 	double roll = 0.0;
 };
 
+// ============================================================================
+// Command パラメータ用の構造体
+// (UPROPERTY のコメントがパラメータの説明、meta = (MCPRequired) で必須指定)
+// ============================================================================
+
+// get_actors_in_level コマンドのパラメータ (Actor フィルタ、一括編集コマンドの selector も同じ形式)
+USTRUCT()
+struct FGetActorsInLevelCommandParams
+{
+	GENERATED_BODY()
+
+	/** Only actors of this class (or a subclass) */
+	UPROPERTY()
+	FString class_name;
+
+	/** Only actors that have this tag */
+	UPROPERTY()
+	FString tag;
+
+	/** Minimum corner {x, y, z} of a world-space box the actor location must be inside */
+	UPROPERTY()
+	FMCPVector3 box_min;
+
+	/** Maximum corner {x, y, z} of a world-space box the actor location must be inside */
+	UPROPERTY()
+	FMCPVector3 box_max;
+
+	// box_min と box_max が指定されたか (パラメータではなく FActorQueryFilter::Decode が設定する)
+	bool bHasBox = false;
+};
+
+// execute_python コマンドのパラメータ
+USTRUCT()
+struct FExecutePythonCommandParams
+{
+	GENERATED_BODY()
+
+	/** Python script content to execute */
+	UPROPERTY(meta = (MCPRequired))
+	FString script_content;
+
+	/** Optional script name for logs and saved script files (auto-generated if not provided) */
+	UPROPERTY()
+	FString script_name;
+
+	/** Optional JSON object passed to the script as `args` (keys are also bound as globals), so the same cached script can run with different inputs */
+	UPROPERTY()
+	FJsonObjectWrapper args;
+
+	/** Optional session id; scripts of the same session share one namespace, so globals they define persist across calls */
+	UPROPERTY()
+	FString session_id;
+
+	/** Return the script's printed and logged output (default true); set to false when the script returns its data through mcp.result() */
+	UPROPERTY()
+	bool include_output = true;
+
+	/** Optional job id for scripts that yield, used to follow and cancel them with python_job (generated if not provided) */
+	UPROPERTY()
+	FString job_id;
+
+	/** Seconds the script may run without yielding before it is interrupted (0 = mcp.Python.TimeoutSeconds) */
+	UPROPERTY()
+	double timeout_seconds = 0.0;
+};
+
+// python_session コマンドのパラメータ
+USTRUCT()
+struct FPythonSessionCommandParams
+{
+	GENERATED_BODY()
+
+	/** Action to perform: "list", "reset", "close" or "close_all" */
+	UPROPERTY(meta = (MCPRequired))
+	FString action;
+
+	/** Session the action applies to (required for reset and close) */
+	UPROPERTY()
+	FString session_id;
+};
+
+// python_job コマンドのパラメータ
+USTRUCT()
+struct FPythonJobCommandParams
+{
+	GENERATED_BODY()
+
+	/** Action to perform: "list" or "cancel" */
+	UPROPERTY(meta = (MCPRequired))
+	FString action;
+
+	/** Job the action applies to (required for cancel) */
+	UPROPERTY()
+	FString job_id;
+};
+
+// spawn_actors で配置する Actor 1 件分
+USTRUCT()
+struct FMCPActorSpawnItem
+{
+	GENERATED_BODY()
+
+	FMCPActorSpawnItem()
+	{
+		scale.x = scale.y = scale.z = 1.0;
+	}
+
+	/** Actor class name or path (Blueprint classes by asset path, e.g. /Game/BP_Tree); ignored when asset is set */
+	UPROPERTY()
+	FString class_name;
+
+	/** Asset to place through its actor factory (static mesh, Blueprint, ...), e.g. /Game/Meshes/SM_Rock */
+	UPROPERTY()
+	FString asset;
+
+	UPROPERTY()
+	FMCPVector3 location;
+
+	UPROPERTY()
+	FMCPRotator rotation;
+
+	UPROPERTY()
+	FMCPVector3 scale;
+
+	/** Optional outliner label */
+	UPROPERTY()
+	FString label;
+
+	/** Optional outliner folder path, e.g. "Props/Rocks" */
+	UPROPERTY()
+	FString folder;
+
+	/** Optional editable actor properties to set before construction, as {"PropertyName": value} */
+	UPROPERTY()
+	FJsonObjectWrapper properties;
+};
+
+// spawn_actors コマンドのパラメータ
+USTRUCT()
+struct FSpawnActorsCommandParams
+{
+	GENERATED_BODY()
+
+	/** Actors to spawn: objects with class_name or asset, location, rotation, scale, label, folder and properties */
+	UPROPERTY(meta = (MCPRequired))
+	TArray<FMCPActorSpawnItem> actors;
+};
+
+// set_actor_transforms で動かす Actor 1 件分 (行形式)
+USTRUCT()
+struct FMCPActorTransformItem
+{
+	GENERATED_BODY()
+
+	/** Actor GUID (id returned by get_actors_in_level or spawn_actors) */
+	UPROPERTY()
+	FString id;
+
+	/** New location [x, y, z] (omit to keep the current one) */
+	UPROPERTY()
+	TArray<double> location;
+
+	/** New rotation [pitch, yaw, roll] (omit to keep the current one) */
+	UPROPERTY()
+	TArray<double> rotation;
+
+	/** New scale [x, y, z] (omit to keep the current one) */
+	UPROPERTY()
+	TArray<double> scale;
+};
+
+// set_actor_transforms コマンドのパラメータ (行形式か列形式のどちらか一方)
+USTRUCT()
+struct FSetActorTransformsCommandParams
+{
+	GENERATED_BODY()
+
+	/** Row format: [{id, location, rotation, scale}], each component an optional [x, y, z] */
+	UPROPERTY()
+	TArray<FMCPActorTransformItem> actors;
+
+	/** Columnar format: actor GUIDs, with locations, rotations and scales as flat arrays of 3 numbers per id */
+	UPROPERTY()
+	TArray<FString> ids;
+
+	/** Columnar format: x, y, z per id (omit to keep locations) */
+	UPROPERTY()
+	TArray<double> locations;
+
+	/** Columnar format: pitch, yaw, roll per id (omit to keep rotations) */
+	UPROPERTY()
+	TArray<double> rotations;
+
+	/** Columnar format: x, y, z per id (omit to keep scales) */
+	UPROPERTY()
+	TArray<double> scales;
+};
+
+// set_properties コマンドのパラメータ (ids か selector のどちらか一方)
+USTRUCT()
+struct FSetPropertiesCommandParams
+{
+	GENERATED_BODY()
+
+	/** Editable properties to set on every selected actor, as {"PropertyPath": value}; paths may go through components and structs, e.g. "StaticMeshComponent.CastShadow" */
+	UPROPERTY(meta = (MCPRequired))
+	FJsonObjectWrapper properties;
+
+	/** Actor GUIDs to edit */
+	UPROPERTY()
+	TArray<FString> ids;
+
+	/** Actor filter {class_name, tag, box_min, box_max} selecting the actors to edit ({} = every actor) */
+	UPROPERTY()
+	FJsonObjectWrapper selector;
+
+	/** Only count the actors that would change, without editing them */
+	UPROPERTY()
+	bool dry_run = false;
+};
+
+// delete_actors コマンドのパラメータ (ids か selector のどちらか一方)
+USTRUCT()
+struct FDeleteActorsCommandParams
+{
+	GENERATED_BODY()
+
+	/** Actor GUIDs to delete */
+	UPROPERTY()
+	TArray<FString> ids;
+
+	/** Actor filter {class_name, tag, box_min, box_max} selecting the actors to delete (at least one criterion is required) */
+	UPROPERTY()
+	FJsonObjectWrapper selector;
+
+	/** Also delete actors that other actors or the level blueprint still reference (the references are left dangling) */
+	UPROPERTY()
+	bool force = false;
+};
+
+// ============================================================================
+// Command レスポンス用の構造体
+// ============================================================================
+
 // Actor 情報
 USTRUCT()
 struct FMCPActorInfo
 {
 	GENERATED_BODY()
 
+	// Actor GUID (エディタ上で名前が変わっても不変)
+	UPROPERTY()
+	FString id;
+
 	UPROPERTY()
 	FString name;
 
+	// アウトライナーの表示名
+	UPROPERTY()
+	FString label;
+
 	UPROPERTY()
 	FString className;
 
+	// アウトライナーのフォルダパス (ルートは空)
+	UPROPERTY()
+	FString folder;
+
+	UPROPERTY()
+	TArray<FString> tags;
+
 	UPROPERTY()
 	FMCPVector3 location;
 
@@ -168,6 +513,13 @@ struct FMCPActorInfo
 
 	UPROPERTY()
 	FMCPVector3 scale;
+
+	// ワールド空間のバウンディングボックス (中心と半径)
+	UPROPERTY()
+	FMCPVector3 boundsOrigin;
+
+	UPROPERTY()
+	FMCPVector3 boundsExtent;
 };
 
 // ping コマンドのレスポンス
@@ -195,10 +547,35 @@ struct FGetActorsInLevelCommandResponse
 	UPROPERTY()
 	int32 count = 0;
 
+	// 応答に使ったワールドスナップショットのリビジョン (ゲームスレッドで直接読んだ場合は 0)
+	UPROPERTY()
+	int64 snapshotRevision = 0;
+
 	UPROPERTY()
 	FString error;
 };
 
+// コンパイル済み Python コードキャッシュの状態
+USTRUCT()
+struct FMCPPythonCodeCacheInfo
+{
+	GENERATED_BODY()
+
+	// このスクリプトがキャッシュから実行されたか
+	UPROPERTY()
+	bool hit = false;
+
+	UPROPERTY()
+	int32 entries = 0;
+
+	// 起動後の累計
+	UPROPERTY()
+	int64 hits = 0;
+
+	UPROPERTY()
+	int64 misses = 0;
+};
+
 // execute_python コマンドのレスポンス
 USTRUCT()
 struct FExecutePythonCommandResponse
@@ -211,9 +588,308 @@ struct FExecutePythonCommandResponse
 	UPROPERTY()
 	FString output;
 
+	// mcp.result() または末尾の式の値 (JSON 文字列のまま data.result に展開、結果がなければ null)
+	UPROPERTY(meta = (MCPRawJson))
+	FString result;
+
+	// スクリプトが出力した総バイト数
+	UPROPERTY()
+	int64 output_bytes = 0;
+
+	// mcp.Python.MaxOutputBytes を超えて output から省略されたバイト数 (0 なら全出力)
+	UPROPERTY()
+	int64 output_truncated_bytes = 0;
+
+	// mcp.Python.SaveScripts 有効時の保存先 (無効時は空)
 	UPROPERTY()
 	FString script_path;
 
+	UPROPERTY()
+	FString job_id;
+
+	// スクリプトを実行したフレーム数 (yield しないスクリプトは 1)
+	UPROPERTY()
+	int32 steps = 0;
+
+	// python_job で中断された
+	UPROPERTY()
+	bool cancelled = false;
+
+	// タイムアウトでウォッチドッグに中断された (output は中断までの出力)
+	UPROPERTY()
+	bool timed_out = false;
+
+	UPROPERTY()
+	FMCPPythonCodeCacheInfo code_cache;
+
+	UPROPERTY()
+	FString error;
+};
+
+// Python セッションの状態
+USTRUCT()
+struct FMCPPythonSessionInfo
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FString id;
+
+	// このセッションで実行したスクリプト数
+	UPROPERTY()
+	int32 runs = 0;
+
+	// 名前空間のグローバル変数の数
+	UPROPERTY()
+	int32 globals = 0;
+
+	// 名前空間から参照されるオブジェクトの概算サイズ (モジュールとクラスは除く)
+	UPROPERTY()
+	int64 memoryBytes = 0;
+
+	UPROPERTY()
+	double ageSeconds = 0.0;
+
+	UPROPERTY()
+	double idleSeconds = 0.0;
+};
+
+// 実行中の Python ジョブの状態
+USTRUCT()
+struct FMCPPythonJobInfo
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FString id;
+
+	UPROPERTY()
+	FString script;
+
+	UPROPERTY()
+	int32 steps = 0;
+
+	// 最後に yield された進捗 (0-1、不明なら負数)
+	UPROPERTY()
+	float progress = -1.0f;
+
+	UPROPERTY()
+	FString message;
+
+	UPROPERTY()
+	double elapsedSeconds = 0.0;
+
+	UPROPERTY()
+	bool cancelRequested = false;
+};
+
+// python_job コマンドのレスポンス
+USTRUCT()
+struct FPythonJobCommandResponse
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	bool success = true;
+
+	// list は全ジョブ、cancel は対象ジョブ
+	UPROPERTY()
+	TArray<FMCPPythonJobInfo> jobs;
+
+	UPROPERTY()
+	FString error;
+};
+
+// python_session コマンドのレスポンス
+USTRUCT()
+struct FPythonSessionCommandResponse
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	bool success = true;
+
+	// list は全セッション、reset は対象セッション、close/close_all は空
+	UPROPERTY()
+	TArray<FMCPPythonSessionInfo> sessions;
+
+	UPROPERTY()
+	FString error;
+};
+
+// 一括コマンドで失敗した要素
+USTRUCT()
+struct FMCPItemError
+{
+	GENERATED_BODY()
+
+	// 入力配列でのインデックス
+	UPROPERTY()
+	int32 index = 0;
+
+	UPROPERTY()
+	FString error;
+};
+
+// spawn_actors コマンドのレスポンス
+USTRUCT()
+struct FSpawnActorsCommandResponse
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	bool success = true;
+
+	// 入力と同じ順の Actor GUID (失敗した要素は空文字)
+	UPROPERTY()
+	TArray<FString> ids;
+
+	UPROPERTY()
+	int32 spawned = 0;
+
+	// 失敗した要素 (他の要素は配置される)
+	UPROPERTY()
+	TArray<FMCPItemError> errors;
+
+	// 配置を分割して実行したフレーム数
+	UPROPERTY()
+	int32 steps = 0;
+
+	UPROPERTY()
+	FString error;
+};
+
+// 一括編集コマンドの段階ごとの所要時間 (ミリ秒、複数フレームにまたがる場合は合計)
+USTRUCT()
+struct FMCPBulkEditTimings
+{
+	GENERATED_BODY()
+
+	// ID やセレクタから Actor を解決 (delete_actors では参照チェックを含む)
+	UPROPERTY()
+	double resolveMs = 0.0;
+
+	// 値の書き込み
+	UPROPERTY()
+	double applyMs = 0.0;
+
+	// エディタへの一括通知
+	UPROPERTY()
+	double notifyMs = 0.0;
+};
+
+// set_actor_transforms コマンドのレスポンス
+USTRUCT()
+struct FSetActorTransformsCommandResponse
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	bool success = true;
+
+	UPROPERTY()
+	int32 moved = 0;
+
+	// 見つからなかった Actor など失敗した要素 (他の要素は適用される)
+	UPROPERTY()
+	TArray<FMCPItemError> errors;
+
+	UPROPERTY()
+	int32 steps = 0;
+
+	UPROPERTY()
+	FMCPBulkEditTimings timings;
+
+	UPROPERTY()
+	FString error;
+};
+
+// set_properties コマンドのレスポンス
+USTRUCT()
+struct FSetPropertiesCommandResponse
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	bool success = true;
+
+	// dry_run の場合は何も変更していない
+	UPROPERTY()
+	bool dry_run = false;
+
+	// 選択された Actor 数
+	UPROPERTY()
+	int32 matched = 0;
+
+	// 値を書き換えた (dry_run では書き換える) Actor 数
+	UPROPERTY()
+	int32 changed = 0;
+
+	// すでに同じ値だったため書き換えなかった Actor 数
+	UPROPERTY()
+	int32 unchanged = 0;
+
+	// プロパティが見つからない Actor など失敗した要素 (他の要素は適用される)
+	UPROPERTY()
+	TArray<FMCPItemError> errors;
+
+	UPROPERTY()
+	int32 steps = 0;
+
+	UPROPERTY()
+	FMCPBulkEditTimings timings;
+
+	UPROPERTY()
+	FString error;
+};
+
+// 参照が残っているため削除しなかった Actor
+USTRUCT()
+struct FMCPSkippedActor
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FString id;
+
+	UPROPERTY()
+	FString label;
+
+	// 参照している Actor やレベルブループリントの名前
+	UPROPERTY()
+	TArray<FString> referenced_by;
+};
+
+// delete_actors コマンドのレスポンス
+USTRUCT()
+struct FDeleteActorsCommandResponse
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	bool success = true;
+
+	// 選択された Actor 数
+	UPROPERTY()
+	int32 matched = 0;
+
+	UPROPERTY()
+	int32 deleted = 0;
+
+	// 参照されているためスキップした Actor (force で削除可能)
+	UPROPERTY()
+	TArray<FMCPSkippedActor> skipped;
+
+	// 見つからない Actor や削除できない Actor (WorldSettings など)
+	UPROPERTY()
+	TArray<FMCPItemError> errors;
+
+	UPROPERTY()
+	int32 steps = 0;
+
+	UPROPERTY()
+	FMCPBulkEditTimings timings;
+
 	UPROPERTY()
 	FString error;
 };
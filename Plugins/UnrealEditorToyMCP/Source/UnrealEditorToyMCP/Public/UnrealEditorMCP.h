@@ -3,6 +3,9 @@
 #pragma once
 
 #include "Modules/ModuleManager.h"
+#include "Logging/LogMacros.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(LogUnrealEditorMCP, Log, All);
 
 class FUnrealEditorMCPModule : public IModuleInterface
 {
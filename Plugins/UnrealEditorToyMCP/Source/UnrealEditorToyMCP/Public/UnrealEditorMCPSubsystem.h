@@ -7,6 +7,7 @@
 #include "UnrealEditorMCPSubsystem.generated.h"
 
 class FUnrealEditorMCPHttpServer;
+class FMCPWorldSnapshotBuilder;
 
 UCLASS()
 class UNREALEDITORMCP_API UUnrealEditorMCPSubsystem : public UEditorSubsystem
@@ -25,6 +26,9 @@ private:
 	// HTTP Server
 	TSharedPtr<FUnrealEditorMCPHttpServer> HttpServer;
 
+	// Actor metadata snapshot of the editor world (read by the HTTP server off the game thread)
+	TSharedPtr<FMCPWorldSnapshotBuilder> WorldSnapshot;
+
 	// HTTP Server functions
 	void StartHttpServer();
 	void StopHttpServer();
@@ -41,6 +41,7 @@ public class UnrealEditorMCP : ModuleRules
 				"HTTPServer",  // HttpServerModule
 				"Json", // JSON parsing
 				"JsonUtilities", // USTRUCT <-> JSON conversion
+				"PythonScriptPlugin", // IPythonScriptPlugin (in-memory script execution)
 				"UnrealEd"  // GEditor access
 			]
 		);
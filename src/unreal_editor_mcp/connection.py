@@ -5,6 +5,7 @@ Handles HTTP REST API communication with the UE5 plugin.
 
 import logging
 import os
+import uuid
 from typing import Dict, Any, Optional
 
 import httpx
@@ -14,26 +15,30 @@ logger = logging.getLogger("UnrealEditorMCP")
 # Configuration - can be overridden via environment variables
 UNREAL_BASE_URL = os.getenv("UNREAL_BASE_URL", "http://localhost:3000")
 REQUEST_TIMEOUT = float(os.getenv("UNREAL_REQUEST_TIMEOUT", "30.0"))
+# Session id sent with every request; the editor schedules sessions fairly against each other
+SESSION_ID = os.getenv("UNREAL_MCP_SESSION") or uuid.uuid4().hex
 
 
 class UnrealConnection:
     """Connection to an Unreal Engine instance via HTTP REST API."""
 
-    def __init__(self, base_url: str = None, timeout: float = None):
+    def __init__(self, base_url: str = None, timeout: float = None, session_id: str = None):
         """Initialize the connection.
 
         Args:
             base_url: Base URL for the Unreal Editor HTTP API (default from env or http://localhost:3000)
             timeout: Request timeout in seconds (default from env or 30.0)
+            session_id: Session id sent as X-MCP-Session (default from env or a random id per process)
         """
         self.base_url = (base_url or UNREAL_BASE_URL).rstrip("/")
         self.timeout = timeout or REQUEST_TIMEOUT
+        self.session_id = session_id or SESSION_ID
         self.client: Optional[httpx.Client] = None
 
     def _get_client(self) -> httpx.Client:
         """Get or create HTTP client."""
         if self.client is None:
-            self.client = httpx.Client(timeout=self.timeout)
+            self.client = httpx.Client(timeout=self.timeout, headers={"X-MCP-Session": self.session_id})
         return self.client
 
     def close(self):
@@ -42,6 +47,24 @@ class UnrealConnection:
             self.client.close()
             self.client = None
 
+    @staticmethod
+    def _log_server_timing(tool_name: str, response: httpx.Response):
+        """Log the per-stage latency reported in the Server-Timing header.
+
+        Args:
+            tool_name: The name of the tool that was called
+            response: HTTP response from Unreal Engine
+        """
+        header = response.headers.get("Server-Timing")
+        if not header or not logger.isEnabledFor(logging.DEBUG):
+            return
+
+        stages = []
+        for entry in header.split(","):
+            name, _, duration = entry.strip().partition(";dur=")
+            stages.append(f"{name}={duration}ms" if duration else name)
+        logger.debug(f"Server timing for '{tool_name}': {' '.join(stages)}")
+
     def check_status(self) -> Optional[Dict[str, Any]]:
         """Check the server status.
 
@@ -90,6 +113,7 @@ class UnrealConnection:
             logger.debug(f"Calling tool '{tool_name}' with params: {payload}")
 
             response = client.post(url, json=payload)
+            self._log_server_timing(tool_name, response)
             response.raise_for_status()
 
             result = response.json()
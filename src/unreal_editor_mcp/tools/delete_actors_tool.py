@@ -0,0 +1,100 @@
+"""
+Delete actors tool.
+"""
+
+from typing import Dict, Any, List, Optional
+
+from .base import EditorTool
+
+
+class DeleteActorsTool(EditorTool):
+    """Delete many actors in one call.
+
+    References are checked once for the whole batch; actors that are still
+    referenced are skipped unless forced. The deletion is one undo step.
+    """
+
+    @property
+    def name(self) -> str:
+        """Get the tool name."""
+        return "delete_actors"
+
+    @property
+    def description(self) -> str:
+        """Get the tool description."""
+        return """Delete many actors from the current level (one undo step).
+
+Prefer this over deleting actors one by one from execute_python: references
+are checked in one pass and the outliner and viewports refresh once.
+
+Pass either ids or selector.
+
+Args:
+    ids: Actor GUIDs to delete (from get_actors_in_level or spawn_actors)
+    selector: Actor filter {class_name, tag, box_min, box_max}; at least one
+        criterion is required
+    force: Also delete actors that other actors or the level blueprint still
+        reference (default false: they are skipped and reported)
+
+Returns:
+    Dictionary containing:
+    - success: Whether every selected actor was deleted
+    - matched: Number of selected actors
+    - deleted: Number of actors deleted
+    - skipped: Actors kept because they are referenced ({id, label, referenced_by})
+    - errors: Items that failed ({index, error}), e.g. unknown ids or WorldSettings
+    - steps: Number of frames the deletion was spread over
+    - timings: Milliseconds spent in each phase ({resolveMs, applyMs, notifyMs})
+    - error: Error message if anything failed"""
+
+    def execute(
+        self,
+        ids: Optional[List[str]] = None,
+        selector: Optional[Dict[str, Any]] = None,
+        force: bool = False
+    ) -> Dict[str, Any]:
+        """Execute the delete actors command.
+
+        Args:
+            ids: Actor GUIDs to delete
+            selector: Actor filter selecting the actors to delete
+            force: Delete referenced actors as well
+
+        Returns:
+            Dictionary containing:
+            - success: Whether every selected actor was deleted
+            - matched: Number of selected actors
+            - deleted: Number of actors deleted
+            - skipped: Actors kept because they are referenced
+            - errors: Items that failed
+            - steps: Frames the deletion took
+            - timings: Milliseconds per phase
+            - error: Error message (if failed)
+        """
+        params = {}
+        if ids:
+            params["ids"] = ids
+        if selector is not None:
+            params["selector"] = selector
+        if force:
+            params["force"] = True
+
+        response = self.call_unreal_tool("delete_actors", params)
+
+        if response.get("success"):
+            data = response.get("data", {})
+            return {
+                "success": data.get("success", False),
+                "matched": data.get("matched", 0),
+                "deleted": data.get("deleted", 0),
+                "skipped": data.get("skipped", []),
+                "errors": data.get("errors", []),
+                "steps": data.get("steps", 0),
+                "timings": data.get("timings", {}),
+                "error": data.get("error", "")
+            }
+
+        return {
+            "success": False,
+            "error": response.get("error", "Unknown error")
+        }
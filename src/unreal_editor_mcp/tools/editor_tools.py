@@ -13,6 +13,12 @@ from .registry import ToolRegistry
 from .ping_tool import PingTool
 from .get_actors_tool import GetActorsInLevelTool
 from .execute_python_tool import ExecutePythonTool
+from .python_session_tool import PythonSessionTool
+from .python_job_tool import PythonJobTool
+from .spawn_actors_tool import SpawnActorsTool
+from .set_actor_transforms_tool import SetActorTransformsTool
+from .set_properties_tool import SetPropertiesTool
+from .delete_actors_tool import DeleteActorsTool
 
 logger = logging.getLogger("UnrealEditorMCP")
 
@@ -39,6 +45,12 @@ def register_editor_tools(mcp: FastMCP):
     registry.register_tool(PingTool())
     registry.register_tool(GetActorsInLevelTool())
     registry.register_tool(ExecutePythonTool())
+    registry.register_tool(PythonSessionTool())
+    registry.register_tool(PythonJobTool())
+    registry.register_tool(SpawnActorsTool())
+    registry.register_tool(SetActorTransformsTool())
+    registry.register_tool(SetPropertiesTool())
+    registry.register_tool(DeleteActorsTool())
 
     # Register all tools with FastMCP
     registry.register_with_mcp(mcp)
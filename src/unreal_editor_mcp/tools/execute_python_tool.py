@@ -2,7 +2,7 @@
 Execute Python script tool.
 """
 
-from typing import Dict, Any
+from typing import Dict, Any, Optional
 
 from .base import EditorTool
 
@@ -27,32 +27,106 @@ class ExecutePythonTool(EditorTool):
 
 Args:
     script_content: The Python script content to execute
-    script_name: Optional name for the script (auto-generated if not provided)
+    script_name: Optional name for the script in logs (auto-generated if not provided)
+    args: Optional JSON object available to the script as `args` (keys are also
+        bound as globals). Pass changing inputs here instead of formatting them
+        into the source, so the compiled script is reused from the cache.
+    session_id: Optional session id. Scripts of the same session share one
+        namespace, so imports, subsystems and indexes built by one call are
+        available to the next. Manage sessions with python_session.
+    include_output: Whether to return what the script printed or logged
+        (default true). Disable it when the script returns its data as a result.
+    job_id: Optional id for the run, used with python_job (generated if not provided)
+    timeout_seconds: Optional limit on how long the script may run without
+        yielding (default mcp.Python.TimeoutSeconds in the editor, 120 s).
+        Past it the script is interrupted with ScriptTimeout (a KeyboardInterrupt)
+        and the call fails with timed_out set and the output printed so far.
+
+A script returns structured data by calling mcp.result(value) or by ending
+with an expression. The value is returned as JSON in `result`. Unreal structs,
+objects, names, enums, sets and numpy arrays are converted automatically.
+
+For level-wide analysis or edits, use mcp.actor_arrays(class_name=..., tag=...,
+box_min=..., box_max=...) instead of per-actor getters. It returns ids, classes,
+class_id and N x 3 location/rotation/scale/bounds_origin/bounds_extent arrays
+(read-only numpy views when numpy is installed). Write back with
+mcp.set_actor_transforms(ids, location=..., rotation=..., scale=...), which is
+one undoable transaction.
+
+Long-running scripts should `yield` regularly (at top level, or end with a call
+to a generator function). The editor resumes them on the next frame, so it
+stays responsive and other tools keep working. Yield a fraction (0-1), a
+(done, total) pair, a message string or {"progress": ..., "message": ...} to
+report progress. `return value` at top level sets the result. Use python_job
+with the job_id to follow progress or cancel between yields. The call returns
+when the script finishes, so jobs longer than UNREAL_REQUEST_TIMEOUT need a
+larger timeout.
 
 Returns:
     Dictionary containing:
     - success: Whether the script executed successfully
-    - output: The output from the Python script execution
-    - script_path: Path where the script was saved
+    - result: Value passed to mcp.result() or of the trailing expression (null if none)
+    - output: The output from the Python script execution (head and tail only
+      if it exceeded mcp.Python.MaxOutputBytes)
+    - output_bytes: Total bytes of output the script produced
+    - output_truncated_bytes: Bytes dropped from the middle of the output
+    - script_path: Path of the saved copy (only when mcp.Python.SaveScripts is enabled)
+    - code_cache: Compiled code cache info (hit, entries, hits, misses)
+    - job_id: Id of the run
+    - steps: Number of frames the script ran in
+    - cancelled: Whether the script was cancelled through python_job
+    - timed_out: Whether the script was interrupted by the timeout
     - error: Error message if execution failed"""
 
-    def execute(self, script_content: str, script_name: str = "") -> Dict[str, Any]:
+    def execute(
+        self,
+        script_content: str,
+        script_name: str = "",
+        args: Optional[Dict[str, Any]] = None,
+        session_id: str = "",
+        include_output: bool = True,
+        job_id: str = "",
+        timeout_seconds: float = 0.0,
+    ) -> Dict[str, Any]:
         """Execute a Python script in Unreal Engine.
 
         Args:
             script_content: The Python script content to execute
             script_name: Optional name for the script (auto-generated if not provided)
+            args: Optional arguments bound into the script's namespace
+            session_id: Optional session whose namespace the script runs in
+            include_output: Whether to return the script's output
+            job_id: Optional id to follow and cancel the run with
+            timeout_seconds: Optional limit on the time between yields (0 = editor default)
 
         Returns:
             Dictionary containing:
             - success: Whether the script executed successfully
+            - result: Structured result of the script
             - output: Script execution output
-            - script_path: Path where script was saved
+            - output_bytes: Total output size in bytes
+            - output_truncated_bytes: Bytes dropped from the output
+            - script_path: Path of the saved copy (empty unless saving is enabled)
+            - code_cache: Compiled code cache info
+            - job_id: Id of the run
+            - steps: Frames the script ran in
+            - cancelled: Whether the script was cancelled
+            - timed_out: Whether the script timed out
             - error: Error message (if failed)
         """
         params = {"script_content": script_content}
         if script_name:
             params["script_name"] = script_name
+        if args:
+            params["args"] = args
+        if session_id:
+            params["session_id"] = session_id
+        if not include_output:
+            params["include_output"] = False
+        if job_id:
+            params["job_id"] = job_id
+        if timeout_seconds > 0:
+            params["timeout_seconds"] = timeout_seconds
 
         response = self.call_unreal_tool("execute_python", params)
 
@@ -60,8 +134,16 @@ Returns:
             data = response.get("data", {})
             return {
                 "success": data.get("success", False),
+                "result": data.get("result"),
                 "output": data.get("output", ""),
+                "output_bytes": data.get("output_bytes", 0),
+                "output_truncated_bytes": data.get("output_truncated_bytes", 0),
                 "script_path": data.get("script_path", ""),
+                "code_cache": data.get("code_cache", {}),
+                "job_id": data.get("job_id", ""),
+                "steps": data.get("steps", 0),
+                "cancelled": data.get("cancelled", False),
+                "timed_out": data.get("timed_out", False),
                 "error": data.get("error", "")
             }
 
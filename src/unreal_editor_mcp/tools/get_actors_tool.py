@@ -2,17 +2,18 @@
 Get actors in level tool.
 """
 
-from typing import Dict, Any
+from typing import Dict, Any, Optional
 
 from .base import EditorTool
 
 
 class GetActorsInLevelTool(EditorTool):
-    """Get all actors in the current editor level.
+    """Get actors in the current editor level.
 
-    This tool retrieves information about all actors in the currently
+    This tool retrieves information about the actors in the currently
     loaded level in the Unreal Editor, including their names, classes,
-    and transform information (location, rotation, scale).
+    and transform information (location, rotation, scale). Results can be
+    narrowed down by class, tag and a world-space box.
     """
 
     @property
@@ -23,32 +24,68 @@ class GetActorsInLevelTool(EditorTool):
     @property
     def description(self) -> str:
         """Get the tool description."""
-        return """Get all actors in the current editor level.
+        return """Get actors in the current editor level.
+
+Args:
+    class_name: Optional actor class name; subclasses match as well
+    tag: Optional actor tag that must be present
+    box_min: Optional minimum corner {x, y, z} of a world-space box
+    box_max: Optional maximum corner {x, y, z} of a world-space box
 
 Returns:
     Dictionary containing:
     - success: Whether the operation succeeded
-    - actors: List of actor information (name, class, location, rotation, scale)
-    - count: Number of actors returned"""
+    - actors: List of actor information (id, name, label, class, folder, tags,
+      location, rotation, scale, bounds)
+    - count: Number of actors returned
+    - snapshotRevision: World snapshot the answer was read from (0 = read live)"""
 
-    def execute(self) -> Dict[str, Any]:
+    def execute(
+        self,
+        class_name: str = "",
+        tag: str = "",
+        box_min: Optional[Dict[str, float]] = None,
+        box_max: Optional[Dict[str, float]] = None,
+    ) -> Dict[str, Any]:
         """Execute the get actors command.
 
+        Args:
+            class_name: Optional actor class name filter
+            tag: Optional actor tag filter
+            box_min: Optional minimum corner of the box filter
+            box_max: Optional maximum corner of the box filter
+
         Returns:
             Dictionary containing:
             - success: Whether the operation succeeded
             - actors: List of actor information
             - count: Number of actors
+            - snapshotRevision: World snapshot revision (0 = read live)
             - error: Error message (if failed)
         """
-        response = self.call_unreal_tool("get_actors_in_level", {})
+        params = {}
+        if class_name:
+            params["class_name"] = class_name
+        if tag:
+            params["tag"] = tag
+        if box_min is not None or box_max is not None:
+            params["box_min"] = box_min
+            params["box_max"] = box_max
+
+        response = self.call_unreal_tool("get_actors_in_level", params)
 
         if response.get("success"):
             data = response.get("data", {})
+            if not data.get("success", True):
+                return {
+                    "success": False,
+                    "error": data.get("error", "Unknown error")
+                }
             return {
                 "success": True,
                 "actors": data.get("actors", []),
-                "count": data.get("count", 0)
+                "count": data.get("count", 0),
+                "snapshotRevision": data.get("snapshotRevision", 0)
             }
 
         return {
@@ -0,0 +1,72 @@
+"""
+Python job tool.
+"""
+
+from typing import Dict, Any
+
+from .base import EditorTool
+
+
+class PythonJobTool(EditorTool):
+    """Follow and cancel execute_python scripts that run across frames.
+
+    Scripts that yield keep running over many editor frames. This tool
+    reports their progress and cancels them while their execute_python call
+    is still pending.
+    """
+
+    @property
+    def name(self) -> str:
+        """Get the tool name."""
+        return "python_job"
+
+    @property
+    def description(self) -> str:
+        """Get the tool description."""
+        return """List running execute_python jobs with their progress, or cancel one.
+
+A cancelled script stops at its next yield (its finally blocks still run), and
+its execute_python call returns with cancelled set.
+
+Args:
+    action: "list" or "cancel"
+    job_id: Job to cancel (the job_id passed to execute_python)
+
+Returns:
+    Dictionary containing:
+    - success: Whether the action succeeded
+    - jobs: Job info (id, script, steps, progress, message, elapsedSeconds,
+      cancelRequested); every job for list, the cancelled job for cancel
+    - error: Error message if the action failed"""
+
+    def execute(self, action: str, job_id: str = "") -> Dict[str, Any]:
+        """Apply a job action.
+
+        Args:
+            action: Action to perform
+            job_id: Job the action applies to
+
+        Returns:
+            Dictionary containing:
+            - success: Whether the action succeeded
+            - jobs: Job info list
+            - error: Error message (if failed)
+        """
+        params = {"action": action}
+        if job_id:
+            params["job_id"] = job_id
+
+        response = self.call_unreal_tool("python_job", params)
+
+        if response.get("success"):
+            data = response.get("data", {})
+            return {
+                "success": data.get("success", False),
+                "jobs": data.get("jobs", []),
+                "error": data.get("error", "")
+            }
+
+        return {
+            "success": False,
+            "error": response.get("error", "Unknown error")
+        }
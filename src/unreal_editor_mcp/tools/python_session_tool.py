@@ -0,0 +1,71 @@
+"""
+Python session management tool.
+"""
+
+from typing import Dict, Any
+
+from .base import EditorTool
+
+
+class PythonSessionTool(EditorTool):
+    """Inspect and manage persistent execute_python sessions.
+
+    Sessions keep a script namespace alive across execute_python calls. This
+    tool lists them with the memory they hold, and resets or closes them.
+    """
+
+    @property
+    def name(self) -> str:
+        """Get the tool name."""
+        return "python_session"
+
+    @property
+    def description(self) -> str:
+        """Get the tool description."""
+        return """List, reset or close persistent execute_python sessions.
+
+Sessions that stay unused longer than mcp.Python.SessionIdleTimeoutSeconds
+(30 minutes by default) are closed automatically.
+
+Args:
+    action: "list", "reset" (fresh namespace, same id), "close" or "close_all"
+    session_id: Session the action applies to (required for reset and close)
+
+Returns:
+    Dictionary containing:
+    - success: Whether the action succeeded
+    - sessions: Session info (id, runs, globals, memoryBytes, ageSeconds,
+      idleSeconds); every session for list, the reset session for reset
+    - error: Error message if the action failed"""
+
+    def execute(self, action: str, session_id: str = "") -> Dict[str, Any]:
+        """Apply a session action.
+
+        Args:
+            action: Action to perform
+            session_id: Session the action applies to
+
+        Returns:
+            Dictionary containing:
+            - success: Whether the action succeeded
+            - sessions: Session info list
+            - error: Error message (if failed)
+        """
+        params = {"action": action}
+        if session_id:
+            params["session_id"] = session_id
+
+        response = self.call_unreal_tool("python_session", params)
+
+        if response.get("success"):
+            data = response.get("data", {})
+            return {
+                "success": data.get("success", False),
+                "sessions": data.get("sessions", []),
+                "error": data.get("error", "")
+            }
+
+        return {
+            "success": False,
+            "error": response.get("error", "Unknown error")
+        }
@@ -0,0 +1,109 @@
+"""
+Set actor transforms tool.
+"""
+
+from typing import Dict, Any, List, Optional
+
+from .base import EditorTool
+
+
+class SetActorTransformsTool(EditorTool):
+    """Move, rotate and/or scale many actors in one call.
+
+    All moves are one undo step, and the editor refreshes navigation,
+    property windows and viewports once for the whole batch instead of once
+    per actor.
+    """
+
+    @property
+    def name(self) -> str:
+        """Get the tool name."""
+        return "set_actor_transforms"
+
+    @property
+    def description(self) -> str:
+        """Get the tool description."""
+        return """Set the location, rotation and/or scale of many actors (one undo step).
+
+Prefer this over one execute_python call per actor: ids are resolved in one
+pass and the editor is notified once for the whole batch.
+
+Pass either rows (actors) or columns (ids + locations/rotations/scales).
+
+Args:
+    actors: Rows, one object per actor:
+        - id: Actor GUID (from get_actors_in_level or spawn_actors)
+        - location: Optional [x, y, z]
+        - rotation: Optional [pitch, yaw, roll] in degrees
+        - scale: Optional [x, y, z]
+    ids: Actor GUIDs, for the columnar format
+    locations: Flat [x0, y0, z0, x1, y1, z1, ...] with 3 numbers per id
+    rotations: Flat [pitch0, yaw0, roll0, ...] with 3 numbers per id
+    scales: Flat [x0, y0, z0, ...] with 3 numbers per id
+
+Components that are omitted keep the actor's current value.
+
+Returns:
+    Dictionary containing:
+    - success: Whether every actor was moved
+    - moved: Number of actors moved
+    - errors: Items that failed ({index, error}); the others are still moved
+    - steps: Number of frames the move was spread over
+    - timings: Milliseconds spent in each phase ({resolveMs, applyMs, notifyMs})
+    - error: Error message if anything failed"""
+
+    def execute(
+        self,
+        actors: Optional[List[Dict[str, Any]]] = None,
+        ids: Optional[List[str]] = None,
+        locations: Optional[List[float]] = None,
+        rotations: Optional[List[float]] = None,
+        scales: Optional[List[float]] = None
+    ) -> Dict[str, Any]:
+        """Execute the set actor transforms command.
+
+        Args:
+            actors: Rows of {id, location, rotation, scale}
+            ids: Actor GUIDs (columnar format)
+            locations: 3 numbers per id (columnar format)
+            rotations: 3 numbers per id (columnar format)
+            scales: 3 numbers per id (columnar format)
+
+        Returns:
+            Dictionary containing:
+            - success: Whether every actor was moved
+            - moved: Number of actors moved
+            - errors: Items that failed
+            - steps: Frames the move took
+            - timings: Milliseconds per phase
+            - error: Error message (if failed)
+        """
+        params = {}
+        if actors:
+            params["actors"] = actors
+        if ids:
+            params["ids"] = ids
+        if locations:
+            params["locations"] = locations
+        if rotations:
+            params["rotations"] = rotations
+        if scales:
+            params["scales"] = scales
+
+        response = self.call_unreal_tool("set_actor_transforms", params)
+
+        if response.get("success"):
+            data = response.get("data", {})
+            return {
+                "success": data.get("success", False),
+                "moved": data.get("moved", 0),
+                "errors": data.get("errors", []),
+                "steps": data.get("steps", 0),
+                "timings": data.get("timings", {}),
+                "error": data.get("error", "")
+            }
+
+        return {
+            "success": False,
+            "error": response.get("error", "Unknown error")
+        }
@@ -0,0 +1,108 @@
+"""
+Set properties tool.
+"""
+
+from typing import Dict, Any, List, Optional
+
+from .base import EditorTool
+
+
+class SetPropertiesTool(EditorTool):
+    """Set editable properties on many actors in one call.
+
+    Actors are picked by id or by a filter. Actors that already have the
+    values are skipped, the rest are edited as one undo step.
+    """
+
+    @property
+    def name(self) -> str:
+        """Get the tool name."""
+        return "set_properties"
+
+    @property
+    def description(self) -> str:
+        """Get the tool description."""
+        return """Set editable properties on many actors (one undo step).
+
+Prefer this over one execute_python call per actor: each property path is
+resolved once per class, each value is converted once, and actors that
+already have the values are not touched.
+
+Pass either ids or selector.
+
+Args:
+    properties: {"PropertyPath": value}. Paths may go through components and
+        structs, e.g. {"StaticMeshComponent.CastShadow": false,
+        "StaticMeshComponent.Mobility": "Movable", "bHidden": true}
+    ids: Actor GUIDs to edit (from get_actors_in_level or spawn_actors)
+    selector: Actor filter {class_name, tag, box_min, box_max}; {} selects
+        every actor in the level
+    dry_run: Only count the actors that would change
+
+Returns:
+    Dictionary containing:
+    - success: Whether every selected actor could be edited
+    - dry_run: Whether nothing was changed
+    - matched: Number of selected actors
+    - changed: Number of actors edited (or that would be, for dry_run)
+    - unchanged: Number of actors that already had the values
+    - errors: Items that failed ({index, error}); the others are still edited
+    - steps: Number of frames the edit was spread over
+    - timings: Milliseconds spent in each phase ({resolveMs, applyMs, notifyMs})
+    - error: Error message if anything failed"""
+
+    def execute(
+        self,
+        properties: Dict[str, Any],
+        ids: Optional[List[str]] = None,
+        selector: Optional[Dict[str, Any]] = None,
+        dry_run: bool = False
+    ) -> Dict[str, Any]:
+        """Execute the set properties command.
+
+        Args:
+            properties: Property paths and values to set
+            ids: Actor GUIDs to edit
+            selector: Actor filter selecting the actors to edit
+            dry_run: Only count the actors that would change
+
+        Returns:
+            Dictionary containing:
+            - success: Whether every selected actor could be edited
+            - dry_run: Whether nothing was changed
+            - matched: Number of selected actors
+            - changed: Number of actors edited
+            - unchanged: Number of actors that already had the values
+            - errors: Items that failed
+            - steps: Frames the edit took
+            - timings: Milliseconds per phase
+            - error: Error message (if failed)
+        """
+        params = {"properties": properties}
+        if ids:
+            params["ids"] = ids
+        if selector is not None:
+            params["selector"] = selector
+        if dry_run:
+            params["dry_run"] = True
+
+        response = self.call_unreal_tool("set_properties", params)
+
+        if response.get("success"):
+            data = response.get("data", {})
+            return {
+                "success": data.get("success", False),
+                "dry_run": data.get("dry_run", False),
+                "matched": data.get("matched", 0),
+                "changed": data.get("changed", 0),
+                "unchanged": data.get("unchanged", 0),
+                "errors": data.get("errors", []),
+                "steps": data.get("steps", 0),
+                "timings": data.get("timings", {}),
+                "error": data.get("error", "")
+            }
+
+        return {
+            "success": False,
+            "error": response.get("error", "Unknown error")
+        }
@@ -0,0 +1,88 @@
+"""
+Spawn actors tool.
+"""
+
+from typing import Dict, Any, List
+
+from .base import EditorTool
+
+
+class SpawnActorsTool(EditorTool):
+    """Spawn many actors into the current editor level in one call.
+
+    All actors are placed as a single undo step. The editor spreads large
+    batches over several frames, so it stays responsive while thousands of
+    actors are placed.
+    """
+
+    @property
+    def name(self) -> str:
+        """Get the tool name."""
+        return "spawn_actors"
+
+    @property
+    def description(self) -> str:
+        """Get the tool description."""
+        return """Spawn many actors into the current editor level (one undo step).
+
+Prefer this over one execute_python call per actor: classes, assets and
+properties are resolved once per batch, and properties are set before the
+construction script runs.
+
+Args:
+    actors: List of actors to spawn. Each item is an object with:
+        - class_name: Actor class name (e.g. "PointLight") or path (Blueprint
+          classes by asset path, e.g. "/Game/BP_Tree"); ignored if asset is set
+        - asset: Asset to place through its actor factory (static mesh,
+          Blueprint, ...), e.g. "/Game/Meshes/SM_Rock"
+        - location: Optional {x, y, z} (default origin)
+        - rotation: Optional {pitch, yaw, roll}
+        - scale: Optional {x, y, z} (default 1, 1, 1)
+        - label: Optional outliner label
+        - folder: Optional outliner folder path, e.g. "Props/Rocks"
+        - properties: Optional {"PropertyName": value} of editable actor properties
+
+Large batches (thousands of actors) may take longer than UNREAL_REQUEST_TIMEOUT;
+raise it or split the batch.
+
+Returns:
+    Dictionary containing:
+    - success: Whether every actor was spawned
+    - ids: Actor GUIDs in input order ("" for items that failed)
+    - spawned: Number of actors spawned
+    - errors: Items that failed ({index, error}); the others are still spawned
+    - steps: Number of frames the spawn was spread over
+    - error: Error message if anything failed"""
+
+    def execute(self, actors: List[Dict[str, Any]]) -> Dict[str, Any]:
+        """Execute the spawn actors command.
+
+        Args:
+            actors: Actors to spawn
+
+        Returns:
+            Dictionary containing:
+            - success: Whether every actor was spawned
+            - ids: Actor GUIDs in input order
+            - spawned: Number of actors spawned
+            - errors: Items that failed
+            - steps: Frames the spawn took
+            - error: Error message (if failed)
+        """
+        response = self.call_unreal_tool("spawn_actors", {"actors": actors})
+
+        if response.get("success"):
+            data = response.get("data", {})
+            return {
+                "success": data.get("success", False),
+                "ids": data.get("ids", []),
+                "spawned": data.get("spawned", 0),
+                "errors": data.get("errors", []),
+                "steps": data.get("steps", 0),
+                "error": data.get("error", "")
+            }
+
+        return {
+            "success": False,
+            "error": response.get("error", "Unknown error")
+        }